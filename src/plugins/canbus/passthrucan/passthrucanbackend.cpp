@@ -74,10 +74,13 @@ PassThruCanBackend::PassThruCanBackend(const QString &name, QObject *parent)
             this, &PassThruCanBackend::ackOpenFinished);
     connect(m_canIO, &PassThruCanIO::closeFinished,
             this, &PassThruCanBackend::ackCloseFinished);
-    connect(m_canIO, &PassThruCanIO::messagesReceived,
-            this, &PassThruCanBackend::enqueueReceivedFrames);
     connect(m_canIO, &PassThruCanIO::messagesSent,
             this, &QCanBusDevice::framesWritten);
+
+    // The receive queue does not need a lock, so hand over the frames directly
+    // from the I/O thread. framesReceived() is still emitted in this thread.
+    connect(m_canIO, &PassThruCanIO::messagesReceived,
+            this, &PassThruCanBackend::enqueueReceivedFrames, Qt::DirectConnection);
 }
 
 PassThruCanBackend::~PassThruCanBackend()
@@ -6,13 +6,17 @@
 #include "libsocketcan.h"
 
 #include <QtSerialBus/qcanbusdevice.h>
+#include <QtSerialBus/private/qcanbusdevice_p.h>
+#include <QtSerialBus/private/qcanbusframefilter_p.h>
 
 #include <QtCore/qdatastream.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdiriterator.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qeventloop.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qsocketnotifier.h>
+#include <QtCore/qtimer.h>
 
 #include <linux/can/error.h>
 #include <linux/can/raw.h>
@@ -45,7 +49,11 @@ const char virtualC[]     = "virtual";
 enum {
     CanFlexibleDataRateMtu = 72,
     TypeSocketCan = 280,
-    DeviceIsActive = 1
+    DeviceIsActive = 1,
+    DefaultReceiveBatchSize = 32,
+    MaximumReceiveBatchSize = 1024,
+    SendBatchSize = 256,
+    SendRetryInterval = 1 // ms
 };
 
 static QByteArray fileContent(const QString &fileName)
@@ -150,6 +158,9 @@ SocketCanBackend::SocketCanBackend(const QString &name) :
     }
 
     resetConfigurations();
+
+    QCanBusDevicePrivate::get(this)->m_writeFramesFunction =
+            [this](const QList<QCanBusFrame> &frames) { return writeFramesBatched(frames); };
 }
 
 SocketCanBackend::~SocketCanBackend()
@@ -170,6 +181,8 @@ void SocketCanBackend::resetConfigurations()
                 QCanBusDevice::CanFdKey, false);
     QCanBusDevice::setConfigurationParameter(
                 QCanBusDevice::BitRateKey, 500000);
+    QCanBusDevice::setConfigurationParameter(
+                QCanBusDevice::ReceiveBatchSizeKey, int(DefaultReceiveBatchSize));
 }
 
 bool SocketCanBackend::open()
@@ -187,6 +200,17 @@ bool SocketCanBackend::open()
 
 void SocketCanBackend::close()
 {
+    stopReceiveThread();
+
+    // like clear(Output), frames which are not written yet are dropped; otherwise
+    // they would wait for a write notification that never comes after reconnecting
+    if (writeNotifier)
+        writeNotifier->setEnabled(false);
+    QCanBusDevicePrivate *d = QCanBusDevicePrivate::get(this);
+    d->outgoingFrames.clear();
+    d->stagedOutgoingFrames = 0;
+    endStaged = 0;
+
     ::close(canSocket);
     canSocket = -1;
 
@@ -236,8 +260,14 @@ bool SocketCanBackend::applyConfigurationParameter(ConfigurationKey key, const Q
     }
     case QCanBusDevice::RawFilterKey:
     {
+        // check every filter before merging, as merging drops filters covered by others
+        const auto requestedFilters = value.value<QList<QCanBusDevice::Filter> >();
+        if (!checkFilters(requestedFilters))
+            return false;
+
+        // the kernel matches every filter one by one, so drop the redundant ones
         const QList<QCanBusDevice::Filter> filterList
-                = value.value<QList<QCanBusDevice::Filter> >();
+                = QCanBusFrameFilter::merged(requestedFilters);
         if (!value.isValid() || filterList.isEmpty()) {
             // permit every frame - no restrictions (filter reset)
             can_filter filters = {0, 0};
@@ -259,13 +289,9 @@ bool SocketCanBackend::applyConfigurationParameter(ConfigurationKey key, const Q
             const QCanBusDevice::Filter f = filterList.at(i);
             can_filter filter = { f.frameId, f.frameIdMask };
 
-            // frame type filter
+            // frame type filter, other types were rejected by checkFilters()
             switch (f.type) {
             default:
-                // any other type cannot be filtered upon
-                setError(tr("Cannot set filter for frame type: %1").arg(f.type),
-                         QCanBusDevice::CanBusError::ConfigurationError);
-                return false;
             case QCanBusFrame::InvalidFrame:
                 break;
             case QCanBusFrame::DataFrame:
@@ -321,6 +347,27 @@ bool SocketCanBackend::applyConfigurationParameter(ConfigurationKey key, const Q
         success = libSocketCan->setBitrate(canSocketName, bitRate);
         break;
     }
+    case QCanBusDevice::ReceiveBatchSizeKey:
+    {
+        // the receive buffers must not change while the receive thread uses them
+        const bool threaded = bool(receiveThread);
+        stopReceiveThread();
+        receiveBatchSize = value.isValid() ? value.toInt() : int(DefaultReceiveBatchSize);
+        setupReceiveBuffers();
+        if (threaded)
+            startReceiveThread();
+        success = true;
+        break;
+    }
+    case QCanBusDevice::ReceiveThreadKey:
+    {
+        if (value.toBool())
+            startReceiveThread();
+        else
+            stopReceiveThread();
+        success = true;
+        break;
+    }
     default:
         setError(tr("Unsupported configuration key: %1").arg(key),
                  QCanBusDevice::CanBusError::ConfigurationError);
@@ -356,11 +403,18 @@ bool SocketCanBackend::connectSocket()
         return false;
     }
 
-    m_iov.iov_base = &m_frame;
-    m_msg.msg_name = &m_address;
-    m_msg.msg_iov = &m_iov;
-    m_msg.msg_iovlen = 1;
-    m_msg.msg_control = &m_ctrlmsg;
+    // let the kernel attach the receive time stamp to each message, so that
+    // a batch of frames can be read without one SIOCGSTAMP ioctl per frame
+    const int timeStamping = 1;
+    kernelTimeStamps = setsockopt(canSocket, SOL_SOCKET, SO_TIMESTAMP,
+                                  &timeStamping, sizeof(timeStamping)) == 0;
+    if (Q_UNLIKELY(!kernelTimeStamps)) {
+        qCWarning(QT_CANBUS_PLUGINS_SOCKETCAN,
+                  "Cannot enable SO_TIMESTAMP, falling back to unbatched reading: %ls",
+                  qUtf16Printable(qt_error_string(errno)));
+    }
+
+    setupReceiveBuffers();
 
     delete notifier;
 
@@ -368,6 +422,28 @@ bool SocketCanBackend::connectSocket()
     connect(notifier, &QSocketNotifier::activated,
             this, &SocketCanBackend::readSocket);
 
+    delete writeNotifier;
+
+    // only enabled while frames are waiting for the socket to become writable again
+    writeNotifier = new QSocketNotifier(canSocket, QSocketNotifier::Write, this);
+    writeNotifier->setEnabled(false);
+    connect(writeNotifier, &QSocketNotifier::activated,
+            this, &SocketCanBackend::writeSocket);
+
+    m_sendBuffers.resize(SendBatchSize);
+    m_sendMessages.resize(SendBatchSize);
+    for (int i = 0; i < SendBatchSize; ++i) {
+        SendBuffer &buffer = m_sendBuffers[i];
+        buffer.iov.iov_base = &buffer.frame;
+
+        msghdr &msg = m_sendMessages[i].msg_hdr;
+        msg = {};
+        msg.msg_iov = &buffer.iov;
+        msg.msg_iovlen = 1;
+    }
+    QCanBusDevicePrivate::get(this)->stagedOutgoingFrames = 0;
+    endStaged = 0;
+
     //apply all stored configurations
     const auto keys = configurationKeys();
     for (ConfigurationKey key : keys) {
@@ -385,30 +461,8 @@ bool SocketCanBackend::connectSocket()
 void SocketCanBackend::setConfigurationParameter(ConfigurationKey key, const QVariant &value)
 {
     if (key == QCanBusDevice::RawFilterKey) {
-        //verify valid/supported filters
-
-        const auto filters = value.value<QList<QCanBusDevice::Filter> >();
-        for (QCanBusDevice::Filter f : filters) {
-            switch (f.type) {
-            case QCanBusFrame::UnknownFrame:
-
-            default:
-                setError(tr("Cannot set filter for frame type: %1").arg(f.type),
-                         QCanBusDevice::CanBusError::ConfigurationError);
-                return;
-            case QCanBusFrame::InvalidFrame:
-            case QCanBusFrame::DataFrame:
-            case QCanBusFrame::ErrorFrame:
-            case QCanBusFrame::RemoteRequestFrame:
-                break;
-            }
-
-            if (f.frameId > 0x1FFFFFFFU) {
-                setError(tr("FrameId %1 larger than 29 bit.").arg(f.frameId),
-                         QCanBusDevice::CanBusError::ConfigurationError);
-                return;
-            }
-        }
+        if (!checkFilters(value.value<QList<QCanBusDevice::Filter> >()))
+            return;
     } else if (key == QCanBusDevice::ProtocolKey) {
         bool ok = false;
         const int newProtocol = value.toInt(&ok);
@@ -419,6 +473,16 @@ void SocketCanBackend::setConfigurationParameter(ConfigurationKey key, const QVa
             return;
         }
         protocol = newProtocol;
+    } else if (key == QCanBusDevice::ReceiveBatchSizeKey && value.isValid()) {
+        bool ok = false;
+        const int batchSize = value.toInt(&ok);
+        if (Q_UNLIKELY(!ok || batchSize < 1 || batchSize > MaximumReceiveBatchSize)) {
+            const QString errorString = tr("Cannot set receive batch size to value %1.")
+                    .arg(value.toString());
+            setError(errorString, QCanBusDevice::ConfigurationError);
+            qCWarning(QT_CANBUS_PLUGINS_SOCKETCAN, "%ls", qUtf16Printable(errorString));
+            return;
+        }
     }
     // connected & params not applyable/invalid
     if (canSocket != -1 && !applyConfigurationParameter(key, value))
@@ -429,18 +493,54 @@ void SocketCanBackend::setConfigurationParameter(ConfigurationKey key, const QVa
     // we need to check CAN FD option a lot -> cache it and avoid QList lookup
     if (key == QCanBusDevice::CanFdKey)
         canFdOptionEnabled = value.toBool();
+    else if (key == QCanBusDevice::ReceiveBatchSizeKey)
+        receiveBatchSize = value.isValid() ? value.toInt() : int(DefaultReceiveBatchSize);
 }
 
-bool SocketCanBackend::writeFrame(const QCanBusFrame &newData)
+bool SocketCanBackend::checkFilters(const QList<QCanBusDevice::Filter> &filters)
 {
-    if (state() != ConnectedState)
-        return false;
+    for (const QCanBusDevice::Filter &f : filters) {
+        switch (f.type) {
+        case QCanBusFrame::UnknownFrame:
+        default:
+            setError(tr("Cannot set filter for frame type: %1").arg(f.type),
+                     QCanBusDevice::CanBusError::ConfigurationError);
+            return false;
+        case QCanBusFrame::InvalidFrame:
+        case QCanBusFrame::DataFrame:
+        case QCanBusFrame::ErrorFrame:
+        case QCanBusFrame::RemoteRequestFrame:
+            break;
+        }
+
+        if (f.frameId > 0x1FFFFFFFU) {
+            setError(tr("FrameId %1 larger than 29 bit.").arg(f.frameId),
+                     QCanBusDevice::CanBusError::ConfigurationError);
+            return false;
+        }
+    }
+    return true;
+}
 
-    if (Q_UNLIKELY(!newData.isValid())) {
+bool SocketCanBackend::checkFrame(const QCanBusFrame &frame)
+{
+    if (Q_UNLIKELY(!frame.isValid())) {
         setError(tr("Cannot write invalid QCanBusFrame"), QCanBusDevice::WriteError);
         return false;
     }
 
+    if (Q_UNLIKELY(!canFdOptionEnabled && frame.hasFlexibleDataRateFormat())) {
+        const QString error = tr("Cannot write CAN FD frame because CAN FD option is not enabled.");
+        qCWarning(QT_CANBUS_PLUGINS_SOCKETCAN, "%ls", qUtf16Printable(error));
+        setError(error, QCanBusDevice::WriteError);
+        return false;
+    }
+
+    return true;
+}
+
+void SocketCanBackend::prepareFrame(const QCanBusFrame &newData, int index)
+{
     canid_t canId = newData.frameId();
     if (newData.hasExtendedFrameFormat())
         canId |= CAN_EFF_FLAG;
@@ -452,34 +552,98 @@ bool SocketCanBackend::writeFrame(const QCanBusFrame &newData)
         canId |= CAN_ERR_FLAG;
     }
 
-    if (Q_UNLIKELY(!canFdOptionEnabled && newData.hasFlexibleDataRateFormat())) {
-        const QString error = tr("Cannot write CAN FD frame because CAN FD option is not enabled.");
-        qCWarning(QT_CANBUS_PLUGINS_SOCKETCAN, "%ls", qUtf16Printable(error));
-        setError(error, QCanBusDevice::WriteError);
-        return false;
+    // the first bytes of canfd_frame are layout compatible with can_frame
+    SendBuffer &buffer = m_sendBuffers[index];
+    buffer.frame = {};
+    buffer.frame.can_id = canId;
+    const QByteArrayView payload = newData.payloadView();
+    buffer.frame.len = payload.size();
+    if (newData.hasFlexibleDataRateFormat()) {
+        buffer.frame.flags = newData.hasBitrateSwitch() ? CANFD_BRS : 0;
+        buffer.frame.flags |= newData.hasErrorStateIndicator() ? CANFD_ESI : 0;
+        buffer.iov.iov_len = CANFD_MTU;
+    } else {
+        buffer.iov.iov_len = CAN_MTU;
     }
+    ::memcpy(buffer.frame.data, payload.data(), buffer.frame.len);
+}
 
-    qint64 bytesWritten = 0;
-    if (newData.hasFlexibleDataRateFormat()) {
-        canfd_frame frame = {};
-        frame.len = newData.payload().size();
-        frame.can_id = canId;
-        frame.flags = newData.hasBitrateSwitch() ? CANFD_BRS : 0;
-        frame.flags |= newData.hasErrorStateIndicator() ? CANFD_ESI : 0;
-        ::memcpy(frame.data, newData.payload().constData(), frame.len);
-
-        bytesWritten = ::write(canSocket, &frame, sizeof(frame));
+/*
+    Hands the prepared frames [first, first + count) to the kernel and returns the
+    number of frames written. If not all frames could be written, \a lastError is
+    set to the errno value of the failing call.
+*/
+int SocketCanBackend::sendPreparedFrames(int first, int count, int *lastError)
+{
+    int sent = 0;
+    *lastError = 0;
+
+    while (sent < count) {
+        const int result = ::sendmmsg(canSocket, m_sendMessages.data() + first + sent,
+                                      count - sent, MSG_DONTWAIT);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            *lastError = errno;
+            break;
+        }
+        sent += result;
+    }
+
+    return sent;
+}
+
+bool SocketCanBackend::hasPendingFrames() const
+{
+    return framesToWrite() > 0;
+}
+
+void SocketCanBackend::schedulePendingWrite(int lastError)
+{
+    if (lastError == ENOBUFS) {
+        // the interface's transmit queue is full: the socket itself is
+        // still writable, so the write notifier would fire immediately
+        QTimer::singleShot(int(SendRetryInterval), this, [this]() {
+            if (canSocket != -1)
+                writeSocket();
+        });
     } else {
-        can_frame frame = {};
-        frame.can_dlc = newData.payload().size();
-        frame.can_id = canId;
-        ::memcpy(frame.data, newData.payload().constData(), frame.can_dlc);
+        writeNotifier->setEnabled(true);
+    }
+}
+
+static bool isTransientWriteError(int error)
+{
+    return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS;
+}
+
+bool SocketCanBackend::writeFrame(const QCanBusFrame &newData)
+{
+    if (state() != ConnectedState)
+        return false;
+
+    if (!checkFrame(newData))
+        return false;
 
-        bytesWritten = ::write(canSocket, &frame, sizeof(frame));
+    // frames which could not be written yet must go out first
+    if (Q_UNLIKELY(hasPendingFrames())) {
+        enqueueOutgoingFrame(newData);
+        return true;
     }
 
+    prepareFrame(newData, 0);
+    const SendBuffer &buffer = m_sendBuffers[0];
+    const qint64 bytesWritten = ::write(canSocket, &buffer.frame, buffer.iov.iov_len);
+
     if (Q_UNLIKELY(bytesWritten < 0)) {
-        setError(qt_error_string(errno),
+        const int lastError = errno;
+        if (isTransientWriteError(lastError)) {
+            // the socket is busy: keep the frame for writeSocket(), like writeFrames()
+            enqueueOutgoingFrame(newData);
+            schedulePendingWrite(lastError);
+            return true;
+        }
+        setError(qt_error_string(lastError),
                  QCanBusDevice::CanBusError::WriteError);
         return false;
     }
@@ -489,6 +653,91 @@ bool SocketCanBackend::writeFrame(const QCanBusFrame &newData)
     return true;
 }
 
+qint64 SocketCanBackend::writeFramesBatched(const QList<QCanBusFrame> &frames)
+{
+    if (state() != ConnectedState)
+        return 0;
+
+    qsizetype valid = 0;
+    while (valid < frames.size() && checkFrame(frames.at(valid)))
+        ++valid;
+
+    qsizetype next = 0;
+    int lastError = 0;
+    const bool writePending = hasPendingFrames();
+    if (!writePending) {
+        while (next < valid) {
+            const int count = int(qMin<qsizetype>(valid - next, SendBatchSize));
+            for (int i = 0; i < count; ++i)
+                prepareFrame(frames.at(next + i), i);
+
+            const int sent = sendPreparedFrames(0, count, &lastError);
+            next += sent;
+            if (lastError != 0)
+                break;
+        }
+
+        if (next > 0)
+            emit framesWritten(next);
+
+        if (lastError != 0 && !isTransientWriteError(lastError)) {
+            setError(qt_error_string(lastError), QCanBusDevice::CanBusError::WriteError);
+            return next;
+        }
+    }
+
+    // the socket is busy: keep the remainder for writeSocket()
+    if (next < valid) {
+        for (qsizetype i = next; i < valid; ++i)
+            enqueueOutgoingFrame(frames.at(i));
+        if (!writePending)
+            schedulePendingWrite(lastError);
+    }
+
+    return valid;
+}
+
+void SocketCanBackend::writeSocket()
+{
+    writeNotifier->setEnabled(false);
+
+    qint64 written = 0;
+    int lastError = 0;
+
+    // reset by QCanBusDevice::clear(), which drops the staged frames as well
+    qsizetype &staged = QCanBusDevicePrivate::get(this)->stagedOutgoingFrames;
+
+    for (;;) {
+        if (staged == 0) {
+            endStaged = 0;
+            while (endStaged < SendBatchSize && hasOutgoingFrames())
+                prepareFrame(dequeueOutgoingFrame(), endStaged++);
+            staged = endStaged;
+            if (endStaged == 0)
+                break;
+        }
+
+        const int sent = sendPreparedFrames(endStaged - int(staged), int(staged), &lastError);
+        staged -= sent;
+        written += sent;
+
+        if (lastError != 0) {
+            if (!isTransientWriteError(lastError)) {
+                // drop the frame which cannot be written at all
+                --staged;
+                setError(qt_error_string(lastError), QCanBusDevice::CanBusError::WriteError);
+            }
+            break;
+        }
+    }
+
+    if (hasPendingFrames())
+        schedulePendingWrite(lastError);
+
+    if (written > 0)
+        emit framesWritten(written);
+}
+
 QString SocketCanBackend::interpretErrorFrame(const QCanBusFrame &errorFrame)
 {
     if (errorFrame.frameType() != QCanBusFrame::ErrorFrame)
@@ -652,63 +901,176 @@ QString SocketCanBackend::interpretErrorFrame(const QCanBusFrame &errorFrame)
     return errorMsg;
 }
 
+void SocketCanBackend::setupReceiveBuffers()
+{
+    // without kernel time stamps in the control messages, the time stamp has to be
+    // requested with SIOCGSTAMP, which only reports the most recently received frame
+    const int batchSize = kernelTimeStamps ? qBound(1, receiveBatchSize,
+                                                    int(MaximumReceiveBatchSize)) : 1;
+
+    m_receiveBuffers.resize(batchSize);
+    m_receiveMessages.resize(batchSize);
+
+    for (int i = 0; i < batchSize; ++i) {
+        ReceiveBuffer &buffer = m_receiveBuffers[i];
+        buffer.iov.iov_base = &buffer.frame;
+        buffer.iov.iov_len = sizeof(buffer.frame);
+
+        msghdr &msg = m_receiveMessages[i].msg_hdr;
+        msg = {};
+        msg.msg_name = &buffer.address;
+        msg.msg_iov = &buffer.iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = &buffer.ctrlmsg;
+    }
+}
+
+static bool controlMessageTimeStamp(msghdr *msg, QCanBusFrame::TimeStamp *stamp)
+{
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET)
+            continue;
+
+        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+            timeval timeStamp;
+            ::memcpy(&timeStamp, CMSG_DATA(cmsg), sizeof(timeStamp));
+            *stamp = QCanBusFrame::TimeStamp(timeStamp.tv_sec, timeStamp.tv_usec);
+            return true;
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec timeStamp;
+            ::memcpy(&timeStamp, CMSG_DATA(cmsg), sizeof(timeStamp));
+            *stamp = QCanBusFrame::TimeStamp(timeStamp.tv_sec, timeStamp.tv_nsec / 1000);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SocketCanBackend::startReceiveThread()
+{
+    if (receiveThread || canSocket == -1)
+        return;
+
+    notifier->setEnabled(false);
+
+    // The read notifier has to live in the thread that reads the socket. Frames are handed
+    // over through the lock-free receive queue, framesReceived() is emitted in our thread.
+    const int socket = int(canSocket);
+    receiveThread.reset(QThread::create([this, socket]() {
+        QSocketNotifier readNotifier(socket, QSocketNotifier::Read);
+        QObject::connect(&readNotifier, &QSocketNotifier::activated,
+                         &readNotifier, [this]() { readSocket(); });
+        QEventLoop loop;
+        loop.exec();
+    }));
+    receiveThread->setObjectName(QStringLiteral("SocketCAN receiver ") + canSocketName);
+    receiveThread->start(QThread::HighPriority);
+}
+
+void SocketCanBackend::stopReceiveThread()
+{
+    if (!receiveThread)
+        return;
+
+    // with BlockWhenFull, the thread might wait for us to read frames
+    QCanBusDevicePrivate *d = QCanBusDevicePrivate::get(this);
+    d->setProducerStopped(true);
+    receiveThread->quit();
+    receiveThread->wait();
+    receiveThread.reset();
+    d->setProducerStopped(false);
+
+    if (notifier)
+        notifier->setEnabled(true);
+}
+
+void SocketCanBackend::reportReadError(const QString &errorText)
+{
+    if (QThread::currentThread() == thread()) {
+        setError(errorText, QCanBusDevice::CanBusError::ReadError);
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this, errorText]() {
+        setError(errorText, QCanBusDevice::CanBusError::ReadError);
+    }, Qt::QueuedConnection);
+}
+
 void SocketCanBackend::readSocket()
 {
     QList<QCanBusFrame> newFrames;
 
-    for (;;) {
-        m_frame = {};
-        m_iov.iov_len = sizeof(m_frame);
-        m_msg.msg_namelen = sizeof(m_addr);
-        m_msg.msg_controllen = sizeof(m_ctrlmsg);
-        m_msg.msg_flags = 0;
+    const int batchSize = int(m_receiveMessages.size());
+    if (Q_UNLIKELY(batchSize == 0))
+        return;
 
-        const int bytesReceived = ::recvmsg(canSocket, &m_msg, 0);
+    for (;;) {
+        for (int i = 0; i < batchSize; ++i) {
+            msghdr &msg = m_receiveMessages[i].msg_hdr;
+            m_receiveBuffers[i].iov.iov_len = sizeof(canfd_frame);
+            msg.msg_namelen = sizeof(sockaddr_can);
+            msg.msg_controllen = sizeof(ReceiveBuffer::ctrlmsg);
+            msg.msg_flags = 0;
+        }
 
-        if (bytesReceived <= 0) {
+        const int messagesReceived = ::recvmmsg(canSocket, m_receiveMessages.data(),
+                                                batchSize, MSG_DONTWAIT, nullptr);
+        if (messagesReceived <= 0)
             break;
-        } else if (Q_UNLIKELY(bytesReceived != CANFD_MTU && bytesReceived != CAN_MTU)) {
-            setError(tr("ERROR SocketCanBackend: incomplete CAN frame"),
-                     QCanBusDevice::CanBusError::ReadError);
-            continue;
-        } else if (Q_UNLIKELY(m_frame.len > bytesReceived - offsetof(canfd_frame, data))) {
-            setError(tr("ERROR SocketCanBackend: invalid CAN frame length"),
-                     QCanBusDevice::CanBusError::ReadError);
-            continue;
-        }
 
-        struct timeval timeStamp = {};
-        if (Q_UNLIKELY(ioctl(canSocket, SIOCGSTAMP, &timeStamp) < 0)) {
-            setError(qt_error_string(errno),
-                     QCanBusDevice::CanBusError::ReadError);
-            timeStamp = {};
-        }
+        for (int i = 0; i < messagesReceived; ++i) {
+            msghdr &msg = m_receiveMessages[i].msg_hdr;
+            canfd_frame &frame = m_receiveBuffers[i].frame;
+            const int bytesReceived = int(m_receiveMessages[i].msg_len);
+
+            if (Q_UNLIKELY(bytesReceived != CANFD_MTU && bytesReceived != CAN_MTU)) {
+                reportReadError(tr("ERROR SocketCanBackend: incomplete CAN frame"));
+                continue;
+            } else if (Q_UNLIKELY(frame.len > bytesReceived - offsetof(canfd_frame, data))) {
+                reportReadError(tr("ERROR SocketCanBackend: invalid CAN frame length"));
+                continue;
+            }
 
-        const QCanBusFrame::TimeStamp stamp(timeStamp.tv_sec, timeStamp.tv_usec);
-        QCanBusFrame bufferedFrame;
-        bufferedFrame.setTimeStamp(stamp);
-        bufferedFrame.setFlexibleDataRateFormat(bytesReceived == CANFD_MTU);
+            QCanBusFrame::TimeStamp stamp;
+            if (!controlMessageTimeStamp(&msg, &stamp)) {
+                struct timeval timeStamp = {};
+                if (Q_UNLIKELY(ioctl(canSocket, SIOCGSTAMP, &timeStamp) < 0)) {
+                    reportReadError(qt_error_string(errno));
+                    timeStamp = {};
+                }
+                stamp = QCanBusFrame::TimeStamp(timeStamp.tv_sec, timeStamp.tv_usec);
+            }
+
+            QCanBusFrame bufferedFrame;
+            bufferedFrame.setTimeStamp(stamp);
+            bufferedFrame.setFlexibleDataRateFormat(bytesReceived == CANFD_MTU);
 
-        bufferedFrame.setExtendedFrameFormat(m_frame.can_id & CAN_EFF_FLAG);
-        Q_ASSERT(m_frame.len <= CANFD_MAX_DLEN);
+            bufferedFrame.setExtendedFrameFormat(frame.can_id & CAN_EFF_FLAG);
+            Q_ASSERT(frame.len <= CANFD_MAX_DLEN);
 
-        if (m_frame.can_id & CAN_RTR_FLAG)
-            bufferedFrame.setFrameType(QCanBusFrame::RemoteRequestFrame);
-        if (m_frame.can_id & CAN_ERR_FLAG)
-            bufferedFrame.setFrameType(QCanBusFrame::ErrorFrame);
-        if (m_frame.flags & CANFD_BRS)
-            bufferedFrame.setBitrateSwitch(true);
-        if (m_frame.flags & CANFD_ESI)
-            bufferedFrame.setErrorStateIndicator(true);
-        if (m_msg.msg_flags & MSG_CONFIRM)
-            bufferedFrame.setLocalEcho(true);
+            if (frame.can_id & CAN_RTR_FLAG)
+                bufferedFrame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+            if (frame.can_id & CAN_ERR_FLAG)
+                bufferedFrame.setFrameType(QCanBusFrame::ErrorFrame);
+            if (frame.flags & CANFD_BRS)
+                bufferedFrame.setBitrateSwitch(true);
+            if (frame.flags & CANFD_ESI)
+                bufferedFrame.setErrorStateIndicator(true);
+            if (msg.msg_flags & MSG_CONFIRM)
+                bufferedFrame.setLocalEcho(true);
 
-        bufferedFrame.setFrameId(m_frame.can_id & CAN_EFF_MASK);
+            bufferedFrame.setFrameId(frame.can_id & CAN_EFF_MASK);
 
-        const QByteArray load(reinterpret_cast<char *>(m_frame.data), m_frame.len);
-        bufferedFrame.setPayload(load);
+            bufferedFrame.setPayload(payloadArena.payload(
+                    reinterpret_cast<const char *>(frame.data), frame.len));
 
-        newFrames.append(std::move(bufferedFrame));
+            newFrames.append(std::move(bufferedFrame));
+        }
+
+        // a short batch means the socket receive queue is drained
+        if (messagesReceived < batchSize)
+            break;
     }
 
     enqueueReceivedFrames(newFrames);
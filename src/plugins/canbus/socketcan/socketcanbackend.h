@@ -7,9 +7,11 @@
 #include <QtSerialBus/qcanbusframe.h>
 #include <QtSerialBus/qcanbusdevice.h>
 #include <QtSerialBus/qcanbusdeviceinfo.h>
+#include <QtSerialBus/private/qcanbusframe_p.h>
 
 #include <QtCore/qsocketnotifier.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qvariant.h>
 
 // The order of the following includes is mandatory, because some
@@ -20,6 +22,7 @@
 #include <sys/time.h>
 
 #include <memory>
+#include <vector>
 
 #ifndef CANFD_MTU
 // CAN FD support was added by Linux kernel 3.6
@@ -75,22 +78,55 @@ public:
 
 private Q_SLOTS:
     void readSocket();
+    void writeSocket();
 
 private:
     void resetConfigurations();
     bool connectSocket();
     bool applyConfigurationParameter(ConfigurationKey key, const QVariant &value);
+    void setupReceiveBuffers();
+    void startReceiveThread();
+    void stopReceiveThread();
+    void reportReadError(const QString &errorText);
+    bool checkFilters(const QList<QCanBusDevice::Filter> &filters);
+    bool checkFrame(const QCanBusFrame &frame);
+    qint64 writeFramesBatched(const QList<QCanBusFrame> &frames);
+    void prepareFrame(const QCanBusFrame &frame, int index);
+    int sendPreparedFrames(int first, int count, int *lastError);
+    bool hasPendingFrames() const;
+    void schedulePendingWrite(int lastError);
+
+    // one slot per frame that can be fetched with a single recvmmsg() call
+    struct ReceiveBuffer {
+        canfd_frame frame;
+        sockaddr_can address;
+        iovec iov;
+        alignas(cmsghdr) char ctrlmsg[CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(__u32))];
+    };
 
     int protocol = CAN_RAW;
-    canfd_frame m_frame;
     sockaddr_can m_address;
-    msghdr m_msg;
-    iovec m_iov;
-    sockaddr_can m_addr;
-    char m_ctrlmsg[CMSG_SPACE(sizeof(timeval)) + CMSG_SPACE(sizeof(__u32))];
+    std::vector<ReceiveBuffer> m_receiveBuffers;
+    std::vector<mmsghdr> m_receiveMessages;
+    int receiveBatchSize = 32;
+    bool kernelTimeStamps = false;
+    QCanBusFramePayloadArena payloadArena;
+
+    // frames prepared for sendmmsg(); the last QCanBusDevicePrivate::stagedOutgoingFrames
+    // of the first endStaged slots were taken from the outgoing queue but could not be
+    // written yet, because the socket was busy
+    struct SendBuffer {
+        canfd_frame frame;
+        iovec iov;
+    };
+    std::vector<SendBuffer> m_sendBuffers;
+    std::vector<mmsghdr> m_sendMessages;
+    int endStaged = 0;
 
     qint64 canSocket = -1;
     QSocketNotifier *notifier = nullptr;
+    QSocketNotifier *writeNotifier = nullptr;
+    std::unique_ptr<QThread> receiveThread;
     std::unique_ptr<LibSocketCan> libSocketCan;
     QString canSocketName;
     bool canFdOptionEnabled = false;
@@ -147,6 +147,9 @@ static QBasicMutex g_serverMutex;
 VirtualCanBackend::VirtualCanBackend(const QString &interface, QObject *parent)
     : QCanBusDevice(parent)
 {
+    // the virtual CAN server forwards all frames, so filter them here
+    setSoftwareFilteringEnabled(true);
+
     m_url = QUrl(interface);
     const QString canDevice = m_url.fileName();
 
@@ -207,8 +210,10 @@ void VirtualCanBackend::close()
 
 void VirtualCanBackend::setConfigurationParameter(ConfigurationKey key, const QVariant &value)
 {
-    if (key == QCanBusDevice::ReceiveOwnKey || key == QCanBusDevice::CanFdKey)
+    if (key == QCanBusDevice::ReceiveOwnKey || key == QCanBusDevice::CanFdKey
+            || key == QCanBusDevice::RawFilterKey) {
         QCanBusDevice::setConfigurationParameter(key, value);
+    }
 }
 
 /*
@@ -7,17 +7,191 @@
 
 #include "qcanbusframe.h"
 
+#include <QtCore/qchronotimer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qeventloop.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qscopedvaluerollback.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
 Q_STATIC_LOGGING_CATEGORY(QT_CANBUS, "qt.canbus")
 
+enum {
+    DefaultReceiveQueueSize = 16384
+};
+
+void QCanBusDevicePrivate::setupIncomingFrames()
+{
+    Q_Q(QCanBusDevice);
+
+    const QVariant policy = q->configurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey);
+    overflowPolicy = policy.isValid() ? policy.value<QCanBusDevice::QueueOverflowPolicy>()
+                                      : QCanBusDevice::DropNewestFrames;
+
+    notificationInterval = qMax<qint64>(
+            q->configurationParameter(QCanBusDevice::ReceiveNotificationIntervalKey).toLongLong(), 0);
+    notificationThreshold = qMax<qsizetype>(
+            q->configurationParameter(QCanBusDevice::ReceiveNotificationThresholdKey).toLongLong(), 0);
+
+    bool ok = false;
+    int capacity = q->configurationParameter(QCanBusDevice::ReceiveQueueSizeKey).toInt(&ok);
+    if (!ok || capacity <= 0)
+        capacity = DefaultReceiveQueueSize;
+
+    if (incomingFrames.capacity() >= capacity && incomingFrames.capacity() < 2 * capacity)
+        return;
+
+    // keep frames which have not been read yet
+    QList<QCanBusFrame> pending;
+    QCanBusFrame frame;
+    while (incomingFrames.pop(&frame))
+        pending.append(std::move(frame));
+
+    incomingFrames.reset(capacity);
+    for (const QCanBusFrame &pendingFrame : std::as_const(pending)) {
+        if (!incomingFrames.push(pendingFrame))
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Waits until frame fits into the queue, or the device is no longer connected,
+// or the producer is stopped.
+bool QCanBusDevicePrivate::pushWhenNotFull(const QCanBusFrame &frame)
+{
+    QMutexLocker locker(&producerMutex);
+    producerWaiting.store(true, std::memory_order_seq_cst);
+    // pairs with the fence in wakeBlockedProducer(), so that either the push
+    // sees the frames read in the meantime, or the consumer wakes us up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool pushed = incomingFrames.push(frame);
+    while (!pushed && connected.load(std::memory_order_relaxed)
+           && !producerStopped.load(std::memory_order_relaxed)) {
+        queueNotFull.wait(&producerMutex);
+        pushed = incomingFrames.push(frame);
+    }
+    producerWaiting.store(false, std::memory_order_relaxed);
+    return pushed;
+}
+
+void QCanBusDevicePrivate::wakeBlockedProducer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!producerWaiting.load(std::memory_order_seq_cst))
+        return;
+
+    QMutexLocker locker(&producerMutex);
+    queueNotFull.wakeAll();
+}
+
+// A backend has to stop the producer before it waits for its receive thread to finish,
+// because frames are neither read nor is the device disconnected while it waits. As
+// long as the producer is stopped, frames which do not fit into the queue are dropped.
+void QCanBusDevicePrivate::setProducerStopped(bool stopped)
+{
+    QMutexLocker locker(&producerMutex);
+    producerStopped.store(stopped, std::memory_order_relaxed);
+    if (stopped)
+        queueNotFull.wakeAll();
+}
+
+// Called by the consumer after it has taken frames from the queue.
+void QCanBusDevicePrivate::framesRead()
+{
+    droppedFramesReported.store(false, std::memory_order_relaxed);
+    wakeBlockedProducer();
+}
+
+void QCanBusDevicePrivate::reportDroppedFrames()
+{
+    Q_Q(QCanBusDevice);
+
+    // report only the first frames dropped since frames were last read
+    if (droppedFramesReported.exchange(true, std::memory_order_relaxed))
+        return;
+
+    auto report = [q]() {
+        q->setError(QCanBusDevice::tr("The receive queue is full, received frames were "
+                                      "dropped."), QCanBusDevice::ReadError);
+    };
+    if (QThread::currentThread() == q->thread())
+        report();
+    else
+        QMetaObject::invokeMethod(q, report, Qt::QueuedConnection);
+}
+
+void QCanBusDevicePrivate::notifyFramesReceived()
+{
+    Q_Q(QCanBusDevice);
+
+    // with a notification interval, the signal is delayed until either the interval
+    // has passed or the threshold of pending frames is reached
+    const bool delayed = notificationInterval > 0
+            && (notificationThreshold == 0 || incomingFrames.size() < notificationThreshold);
+
+    if (QThread::currentThread() == q->thread()) {
+        if (delayed)
+            scheduleFramesReceived();
+        else
+            emitFramesReceived();
+        return;
+    }
+
+    // Frames enqueued by a worker thread of the backend: emit the signal in the
+    // device's thread, and only once for all frames enqueued in the meantime.
+    if (delayed) {
+        // pairs with the exchange in emitFramesReceived(), so the frames pushed
+        // before are visible to whoever handles the pending notification
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (notificationScheduled.load(std::memory_order_seq_cst))
+            return;
+    }
+
+    if (framesReceivedPending.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    QMetaObject::invokeMethod(q, [this]() {
+        framesReceivedPending.exchange(false, std::memory_order_acq_rel);
+        notifyFramesReceived();
+    }, Qt::QueuedConnection);
+}
+
+void QCanBusDevicePrivate::scheduleFramesReceived()
+{
+    Q_Q(QCanBusDevice);
+
+    if (notificationScheduled.load(std::memory_order_relaxed))
+        return;
+
+    if (!notificationTimer) {
+        notificationTimer = new QChronoTimer(q);
+        notificationTimer->setSingleShot(true);
+        notificationTimer->setTimerType(Qt::PreciseTimer);
+        QObject::connect(notificationTimer, &QChronoTimer::timeout, q, [this]() {
+            emitFramesReceived();
+        });
+    }
+
+    notificationTimer->setInterval(std::chrono::microseconds(notificationInterval));
+    notificationScheduled.store(true, std::memory_order_seq_cst);
+    notificationTimer->start();
+}
+
+void QCanBusDevicePrivate::emitFramesReceived()
+{
+    Q_Q(QCanBusDevice);
+
+    if (notificationScheduled.exchange(false, std::memory_order_seq_cst))
+        notificationTimer->stop();
+
+    notificationCount.fetch_add(1, std::memory_order_relaxed);
+    emit q->framesReceived();
+}
+
 /*!
     \class QCanBusDevice
     \inmodule QtSerialBus
@@ -93,6 +267,51 @@ Q_STATIC_LOGGING_CATEGORY(QT_CANBUS, "qt.canbus")
     \value ProtocolKey      This key allows to specify another protocol. For now, this
                             parameter can only be set and used in the SocketCAN plugin.
                             This enum value was introduced in Qt 5.14.
+    \value ReceiveBatchSizeKey This key defines the maximum number of frames that are fetched
+                            from the CAN driver with a single system call. Larger values
+                            reduce the per-frame overhead at high bus loads. The expected
+                            value for this key is \c int. For now, this parameter can only
+                            be set and used in the SocketCAN plugin.
+                            This enum value was introduced in Qt 6.9.
+    \value ReceiveQueueSizeKey This key defines the maximum number of received frames
+                            that are buffered until they are read with \l readFrame()
+                            or \l readAllFrames(). The value is rounded up to the next
+                            power of two. The expected value for this key is \c int,
+                            the default is 16384 frames. The key takes effect on the
+                            next call to \l connectDevice(). Before Qt 6.9, the
+                            number of buffered frames was not limited. Frames which
+                            do not fit into the queue are counted by \l framesDropped(),
+                            and reported with a \l {QCanBusDevice::}{ReadError}.
+                            This enum value was introduced in Qt 6.9.
+    \value ReceiveQueueOverflowPolicyKey This key defines what happens with received
+                            frames if the receive queue is full. The expected value
+                            for this key is \l QCanBusDevice::QueueOverflowPolicy,
+                            the default is \l {QCanBusDevice::}{DropNewestFrames}.
+                            This enum value was introduced in Qt 6.9.
+    \value ReceiveThreadKey This key defines whether the backend receives frames in an
+                            internal thread instead of the thread the QCanBusDevice lives
+                            in. This avoids losing frames in the driver if the event loop
+                            of the device's thread is busy. The frames are put into the
+                            receive queue and \l framesReceived() is emitted in the
+                            device's thread. The expected value for this key is \c bool,
+                            the default is \c false. For now, this parameter can only
+                            be set and used in the SocketCAN plugin.
+                            This enum value was introduced in Qt 6.9.
+    \value ReceiveNotificationIntervalKey This key defines the maximum time in microseconds
+                            by which the \l framesReceived() signal may be delayed, so that
+                            frames received in the meantime are reported with a single
+                            signal. The expected value for this key is \c int, the default
+                            is \c 0, which emits the signal for every batch of frames
+                            passed to \l enqueueReceivedFrames(). The key takes effect on
+                            the next call to \l connectDevice().
+                            This enum value was introduced in Qt 6.9.
+    \value ReceiveNotificationThresholdKey This key defines the number of pending frames
+                            after which a delayed \l framesReceived() signal is emitted
+                            immediately. The expected value for this key is \c int, the
+                            default is \c 0, which only waits for the
+                            \l {QCanBusDevice::}{ReceiveNotificationIntervalKey} to pass.
+                            The key takes effect on the next call to \l connectDevice().
+                            This enum value was introduced in Qt 6.9.
     \value UserKey          This key defines the range where custom keys start. Its most
                             common purpose is to permit platform-specific configuration
                             options.
@@ -100,6 +319,30 @@ Q_STATIC_LOGGING_CATEGORY(QT_CANBUS, "qt.canbus")
     \sa configurationParameter()
 */
 
+/*!
+    \enum QCanBusDevice::QueueOverflowPolicy
+    \since 6.9
+
+    This enum describes how received frames are handled if the receive queue
+    is full. See \l {QCanBusDevice::}{ReceiveQueueSizeKey}.
+
+    \value DropNewestFrames    The newly received frames are discarded.
+    \value DropOldestFrames    The oldest frames in the queue are discarded to make
+                               room for the newly received frames.
+    \value BlockWhenFull       The backend waits until frames are read from the queue.
+                               This is only possible for backends that receive frames
+                               in their own thread. If the frames are received in the
+                               thread of the QCanBusDevice, the newest frames are
+                               discarded instead. While the backend stops its thread,
+                               for example when the device is disconnected, the frames
+                               which do not fit are discarded, too.
+
+    Every discarded frame is counted by \l framesDropped(). When frames start
+    to be discarded, \l errorOccurred() is emitted with a
+    \l {QCanBusDevice::}{ReadError}. It is emitted again only after frames
+    were read from the queue in the meantime.
+*/
+
 /*!
     \class QCanBusDevice::Filter
     \inmodule QtSerialBus
@@ -210,6 +453,10 @@ Q_STATIC_LOGGING_CATEGORY(QT_CANBUS, "qt.canbus")
 QCanBusDevice::QCanBusDevice(QObject *parent) :
     QObject(*new QCanBusDevicePrivate, parent)
 {
+    Q_D(QCanBusDevice);
+
+    // set up here and in connectDevice() only, as frames may be enqueued from another thread
+    d->setupIncomingFrames();
 }
 
 
@@ -257,6 +504,22 @@ void QCanBusDevice::clearError()
 
     Subclasses must call this function when they receive frames.
 
+    The internal list is a bounded queue. If it is full, the frames are
+    handled according to the \l {QCanBusDevice::}{ReceiveQueueOverflowPolicyKey}
+    configuration, and discarded frames are reported with a
+    \l {QCanBusDevice::}{ReadError}, see \l {QCanBusDevice::}{QueueOverflowPolicy}.
+    The function does not take a lock, so it may be called from
+    a worker thread of the backend. It must not be called from more than one
+    thread concurrently. If it is called from another thread than the one the
+    QCanBusDevice lives in, \l framesReceived() is emitted in the device's thread.
+
+    The signal may be delayed and emitted once for several calls of this function,
+    see \l {QCanBusDevice::}{ReceiveNotificationIntervalKey}.
+
+    If software filtering is enabled, frames which do not match the
+    \l {QCanBusDevice::}{RawFilterKey} are discarded.
+
+    \sa setSoftwareFilteringEnabled()
 */
 void QCanBusDevice::enqueueReceivedFrames(const QList<QCanBusFrame> &newFrames)
 {
@@ -265,10 +528,77 @@ void QCanBusDevice::enqueueReceivedFrames(const QList<QCanBusFrame> &newFrames)
     if (Q_UNLIKELY(newFrames.isEmpty()))
         return;
 
-    d->incomingFramesGuard.lock();
-    d->incomingFrames.append(newFrames);
-    d->incomingFramesGuard.unlock();
-    emit framesReceived();
+    const bool filtering = d->softwareFiltering && !d->frameFilter.acceptsAll();
+
+    qsizetype notified = 0;
+    qsizetype queued = 0;
+    bool dropped = false;
+    for (const QCanBusFrame &frame : newFrames) {
+        if (filtering && !d->frameFilter.accepts(frame))
+            continue;
+
+        bool pushed = d->incomingFrames.push(frame);
+        while (Q_UNLIKELY(!pushed)) {
+            if (d->overflowPolicy == DropOldestFrames) {
+                QCanBusFrame oldest;
+                if (d->incomingFrames.pop(&oldest)) {
+                    d->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                    dropped = true;
+                }
+            } else if (d->overflowPolicy == BlockWhenFull && QThread::currentThread() != thread()
+                       && d->connected.load(std::memory_order_relaxed)
+                       && !d->producerStopped.load(std::memory_order_relaxed)) {
+                // the consumer might wait for this signal before reading
+                if (queued > notified) {
+                    notified = queued;
+                    d->notifyFramesReceived();
+                }
+                pushed = d->pushWhenNotFull(frame);
+                if (!pushed) {
+                    d->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                    dropped = true;
+                }
+                break;
+            } else {
+                d->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                dropped = true;
+                break;
+            }
+            pushed = d->incomingFrames.push(frame);
+        }
+        if (pushed)
+            ++queued;
+    }
+
+    d->receivedFrameCount.fetch_add(queued, std::memory_order_relaxed);
+
+    if (Q_UNLIKELY(dropped))
+        d->reportDroppedFrames();
+
+    if (queued > notified)
+        d->notifyFramesReceived();
+}
+
+/*!
+    \since 6.9
+
+    Enables filtering of received frames in \l enqueueReceivedFrames(), if \a enabled
+    is \c true. The frames are then matched against the list of
+    \l {QCanBusDevice::Filter}{filters} set with the \l {QCanBusDevice::}{RawFilterKey},
+    so that the application only sees the frames it is interested in.
+
+    Backends, which cannot filter frames in the driver or the hardware, should call this
+    function in their constructor. The filters must only be changed in the device's
+    thread, so a backend which enqueues frames from a worker thread has to filter on
+    its own.
+*/
+void QCanBusDevice::setSoftwareFilteringEnabled(bool enabled)
+{
+    Q_D(QCanBusDevice);
+
+    d->softwareFiltering = enabled;
+    d->frameFilter.setFilters(enabled
+            ? configurationParameter(RawFilterKey).value<QList<Filter>>() : QList<Filter>());
 }
 
 /*!
@@ -326,6 +656,9 @@ void QCanBusDevice::setConfigurationParameter(ConfigurationKey key, const QVaria
 {
     Q_D(QCanBusDevice);
 
+    if (key == RawFilterKey && d->softwareFiltering)
+        d->frameFilter.setFilters(value.value<QList<Filter>>());
+
     for (int i = 0; i < d->configOptions.size(); i++) {
         if (d->configOptions.at(i).first == key) {
             if (value.isValid()) {
@@ -419,6 +752,49 @@ qint64 QCanBusDevice::framesAvailable() const
     return d_func()->incomingFrames.size();
 }
 
+/*!
+    \since 6.9
+
+    Returns the number of received frames that were discarded because the
+    receive queue was full. The counter is reset by \l connectDevice().
+
+    \sa framesAvailable(), {QCanBusDevice::}{ReceiveQueueSizeKey},
+        {QCanBusDevice::}{ReceiveQueueOverflowPolicyKey}
+*/
+qint64 QCanBusDevice::framesDropped() const
+{
+    return d_func()->droppedFrames.load(std::memory_order_relaxed);
+}
+
+/*!
+    \since 6.9
+
+    Returns how often \l framesReceived() was emitted since the last call of
+    \l connectDevice(). Compared to \l receivedFrameCount(), this shows how many
+    frames are reported per signal.
+
+    \sa {QCanBusDevice::}{ReceiveNotificationIntervalKey},
+        {QCanBusDevice::}{ReceiveNotificationThresholdKey}
+*/
+qint64 QCanBusDevice::receiveNotificationCount() const
+{
+    return d_func()->notificationCount.load(std::memory_order_relaxed);
+}
+
+/*!
+    \since 6.9
+
+    Returns the number of frames put into the receive queue since the last call
+    of \l connectDevice(). Frames which were dropped because the queue was full
+    are not counted.
+
+    \sa receiveNotificationCount(), framesDropped()
+*/
+qint64 QCanBusDevice::receivedFrameCount() const
+{
+    return d_func()->receivedFrameCount.load(std::memory_order_relaxed);
+}
+
 /*!
     For buffered devices, this function returns the number of frames waiting to be written.
     For unbuffered devices, this function always returns zero.
@@ -431,7 +807,8 @@ qint64 QCanBusDevice::framesAvailable() const
 */
 qint64 QCanBusDevice::framesToWrite() const
 {
-    return d_func()->outgoingFrames.size();
+    Q_D(const QCanBusDevice);
+    return d->outgoingFrames.size() + d->stagedOutgoingFrames;
 }
 
 /*!
@@ -540,12 +917,14 @@ void QCanBusDevice::clear(QCanBusDevice::Directions direction)
     clearError();
 
     if (direction & Direction::Input) {
-        QMutexLocker locker(&d->incomingFramesGuard);
         d->incomingFrames.clear();
+        d->framesRead();
     }
 
-    if (direction & Direction::Output)
+    if (direction & Direction::Output) {
         d->outgoingFrames.clear();
+        d->stagedOutgoingFrames = 0;
+    }
 }
 
 /*!
@@ -739,12 +1118,12 @@ QCanBusFrame QCanBusDevice::readFrame()
 
     clearError();
 
-    QMutexLocker locker(&d->incomingFramesGuard);
-
-    if (Q_UNLIKELY(d->incomingFrames.isEmpty()))
+    QCanBusFrame frame;
+    if (Q_UNLIKELY(!d->incomingFrames.pop(&frame)))
         return QCanBusFrame(QCanBusFrame::InvalidFrame);
 
-    return d->incomingFrames.takeFirst();
+    d->framesRead();
+    return frame;
 }
 
 /*!
@@ -769,13 +1148,63 @@ QList<QCanBusFrame> QCanBusDevice::readAllFrames()
 
     clearError();
 
-    QMutexLocker locker(&d->incomingFramesGuard);
-
     QList<QCanBusFrame> result;
-    result.swap(d->incomingFrames);
+    result.reserve(d->incomingFrames.size());
+
+    QCanBusFrame frame;
+    while (d->incomingFrames.pop(&frame))
+        result.append(std::move(frame));
+
+    if (!result.isEmpty())
+        d->framesRead();
     return result;
 }
 
+/*!
+    \since 6.9
+
+    Moves up to \a maxCount frames from the queue into the array \a frames
+    and returns the number of frames read. The returned frames are removed
+    from the queue.
+
+    Unlike readAllFrames(), this function does not allocate memory, so a
+    caller can drain the queue into the same buffer over and over again.
+
+    The queue operates according to the FIFO principle.
+
+    \sa readFrame(), readAllFrames(), framesAvailable()
+*/
+qsizetype QCanBusDevice::readFrames(QCanBusFrame *frames, qsizetype maxCount)
+{
+    Q_D(QCanBusDevice);
+
+    if (Q_UNLIKELY(d->state != ConnectedState)) {
+        const QString error = tr("Cannot read frame as device is not connected.");
+        qCWarning(QT_CANBUS, "%ls", qUtf16Printable(error));
+        setError(error, CanBusError::OperationError);
+        return 0;
+    }
+
+    clearError();
+
+    qsizetype count = 0;
+    while (count < maxCount && d->incomingFrames.pop(frames + count))
+        ++count;
+
+    if (count > 0)
+        d->framesRead();
+    return count;
+}
+
+/*!
+    \fn qsizetype QCanBusDevice::readFrames(QSpan<QCanBusFrame> frames)
+    \since 6.9
+    \overload
+
+    Moves up to \c{frames.size()} frames from the queue into \a frames
+    and returns the number of frames read.
+*/
+
 /*!
     \fn void QCanBusDevice::framesWritten(qint64 framesCount)
 
@@ -807,6 +1236,39 @@ QList<QCanBusFrame> QCanBusDevice::readAllFrames()
     \sa QCanBusFrame::setPayload()
 */
 
+/*!
+    \since 6.9
+
+    Writes all \a frames to the CAN bus in the given order and returns the
+    number of frames that were accepted for writing.
+
+    If the returned value is smaller than the number of \a frames, writing
+    stopped at the first frame that could not be written and error() describes
+    the reason. The remaining frames are not written.
+
+    Unless the backend is able to hand off several frames to the driver at
+    once, this function calls writeFrame() for every frame. Backends which
+    write several frames at once may emit a single \l framesWritten() signal
+    for all of them.
+
+    \sa writeFrame(), framesWritten()
+*/
+qint64 QCanBusDevice::writeFrames(const QList<QCanBusFrame> &frames)
+{
+    Q_D(QCanBusDevice);
+
+    if (d->m_writeFramesFunction)
+        return d->m_writeFramesFunction(frames);
+
+    qint64 written = 0;
+    for (const QCanBusFrame &frame : frames) {
+        if (!writeFrame(frame))
+            break;
+        ++written;
+    }
+    return written;
+}
+
 /*!
     \fn QString QCanBusDevice::interpretErrorFrame(const QCanBusFrame &frame)
 
@@ -838,6 +1300,12 @@ bool QCanBusDevice::connectDevice()
 
     setState(ConnectingState);
 
+    d->setupIncomingFrames();
+    d->droppedFrames.store(0, std::memory_order_relaxed);
+    d->droppedFramesReported.store(false, std::memory_order_relaxed);
+    d->notificationCount.store(0, std::memory_order_relaxed);
+    d->receivedFrameCount.store(0, std::memory_order_relaxed);
+
     if (!open()) {
         setState(UnconnectedState);
         return false;
@@ -907,6 +1375,9 @@ void QCanBusDevice::setState(QCanBusDevice::CanBusDeviceState newState)
         return;
 
     d->state = newState;
+    d->connected.store(newState == ConnectedState, std::memory_order_relaxed);
+    if (newState != ConnectedState)
+        d->wakeBlockedProducer(); // which then gives up
     emit stateChanged(newState);
 }
 
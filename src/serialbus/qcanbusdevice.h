@@ -6,6 +6,7 @@
 #define QCANBUSDEVICE_H
 
 #include <QtCore/qobject.h>
+#include <QtCore/qspan.h>
 #include <QtSerialBus/qcanbusframe.h>
 #include <QtSerialBus/qcanbusdeviceinfo.h>
 
@@ -60,10 +61,23 @@ public:
         CanFdKey,
         DataBitRateKey,
         ProtocolKey,
+        ReceiveBatchSizeKey,
+        ReceiveQueueSizeKey,
+        ReceiveQueueOverflowPolicyKey,
+        ReceiveThreadKey,
+        ReceiveNotificationIntervalKey,
+        ReceiveNotificationThresholdKey,
         UserKey = 30
     };
     Q_ENUM(ConfigurationKey)
 
+    enum QueueOverflowPolicy {
+        DropNewestFrames,
+        DropOldestFrames,
+        BlockWhenFull
+    };
+    Q_ENUM(QueueOverflowPolicy)
+
     struct Filter
     {
         friend constexpr bool operator==(const Filter &a, const Filter &b) noexcept
@@ -97,10 +111,17 @@ public:
     QList<ConfigurationKey> configurationKeys() const;
 
     virtual bool writeFrame(const QCanBusFrame &frame) = 0;
+    qint64 writeFrames(const QList<QCanBusFrame> &frames);
     QCanBusFrame readFrame();
     QList<QCanBusFrame> readAllFrames();
+    qsizetype readFrames(QCanBusFrame *frames, qsizetype maxCount);
+    qsizetype readFrames(QSpan<QCanBusFrame> frames)
+    { return readFrames(frames.data(), frames.size()); }
     qint64 framesAvailable() const;
     qint64 framesToWrite() const;
+    qint64 framesDropped() const;
+    qint64 receiveNotificationCount() const;
+    qint64 receivedFrameCount() const;
 
     virtual void resetController();
     virtual bool hasBusStatus() const;
@@ -140,6 +161,7 @@ protected:
     void clearError();
 
     void enqueueReceivedFrames(const QList<QCanBusFrame> &newFrames);
+    void setSoftwareFilteringEnabled(bool enabled);
 
     void enqueueOutgoingFrame(const QCanBusFrame &newFrame);
     QCanBusFrame dequeueOutgoingFrame();
@@ -165,6 +187,7 @@ protected:
 Q_DECLARE_TYPEINFO(QCanBusDevice::CanBusError, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QCanBusDevice::CanBusDeviceState, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QCanBusDevice::ConfigurationKey, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(QCanBusDevice::QueueOverflowPolicy, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QCanBusDevice::Filter, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QCanBusDevice::Filter::FormatFilter, Q_PRIMITIVE_TYPE);
 
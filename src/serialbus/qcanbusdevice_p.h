@@ -4,11 +4,17 @@
 #ifndef QCANBUSDEVICE_P_H
 #define QCANBUSDEVICE_P_H
 
-#include <QtCore/qmutex.h>
 #include <QtSerialBus/qcanbusdevice.h>
 
+#include <private/qcanbusframefilter_p.h>
 #include <private/qobject_p.h>
 
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <memory>
+
 //
 //  W A R N I N G
 //  -------------
@@ -22,28 +28,170 @@
 
 QT_BEGIN_NAMESPACE
 
+class QChronoTimer;
+
 typedef QPair<QCanBusDevice::ConfigurationKey, QVariant > ConfigEntry;
 
+/*
+    Bounded lock-free queue for received frames.
+
+    Frames are pushed by exactly one producer (the thread of the backend's I/O),
+    while they may be popped by the consumer and by the producer itself, when it
+    needs to make room for a new frame. Each slot carries a sequence number, which
+    tells whether the slot can be written (sequence == position) or read
+    (sequence == position + 1), so the slot's frame is only ever accessed by the
+    thread that successfully claimed it.
+*/
+class QCanBusFrameQueue
+{
+    Q_DISABLE_COPY_MOVE(QCanBusFrameQueue)
+public:
+    QCanBusFrameQueue() = default;
+
+    // not thread-safe, must only be called while no other thread uses the queue
+    void reset(qsizetype newCapacity)
+    {
+        quint64 size = 1;
+        while (size < quint64(qMax<qsizetype>(newCapacity, 1)))
+            size <<= 1;
+
+        slots.reset(new Slot[size]);
+        for (quint64 i = 0; i < size; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        mask = size - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    qsizetype capacity() const noexcept { return slots ? qsizetype(mask + 1) : 0; }
+
+    // producer only
+    bool push(const QCanBusFrame &frame)
+    {
+        if (Q_UNLIKELY(!slots))
+            return false;
+
+        const quint64 position = head.load(std::memory_order_relaxed);
+        Slot &slot = slots[position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position)
+            return false; // full
+
+        slot.frame = frame;
+        slot.sequence.store(position + 1, std::memory_order_release);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(QCanBusFrame *frame)
+    {
+        if (Q_UNLIKELY(!slots))
+            return false;
+
+        quint64 position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot &slot = slots[position & mask];
+            const quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+            const qint64 difference = qint64(sequence - (position + 1));
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+                    *frame = std::move(slot.frame);
+                    slot.frame = QCanBusFrame();
+                    slot.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // empty
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    qsizetype size() const noexcept
+    {
+        const quint64 last = tail.load(std::memory_order_acquire);
+        const quint64 first = head.load(std::memory_order_acquire);
+        return first > last ? qsizetype(first - last) : 0;
+    }
+
+    void clear()
+    {
+        QCanBusFrame frame;
+        while (pop(&frame)) { }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<quint64> sequence;
+        QCanBusFrame frame;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    quint64 mask = 0;
+    alignas(64) std::atomic<quint64> head = 0;
+    alignas(64) std::atomic<quint64> tail = 0;
+};
+
 class QCanBusDevicePrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QCanBusDevice)
 public:
     QCanBusDevicePrivate() {}
 
+    static QCanBusDevicePrivate *get(QCanBusDevice *device) { return device->d_func(); }
+
     QCanBusDevice::CanBusError lastError = QCanBusDevice::CanBusError::NoError;
     QCanBusDevice::CanBusDeviceState state = QCanBusDevice::UnconnectedState;
     QString errorText;
 
-    QList<QCanBusFrame> incomingFrames;
-    QMutex incomingFramesGuard;
+    void setupIncomingFrames();
+    bool pushWhenNotFull(const QCanBusFrame &frame);
+    void wakeBlockedProducer();
+    void setProducerStopped(bool stopped);
+    void framesRead();
+    void reportDroppedFrames();
+    void notifyFramesReceived();
+    void scheduleFramesReceived();
+    void emitFramesReceived();
+
+    QCanBusFrameQueue incomingFrames;
+    QCanBusDevice::QueueOverflowPolicy overflowPolicy = QCanBusDevice::DropNewestFrames;
+    std::atomic<qint64> droppedFrames = 0;
+    std::atomic<bool> connected = false; // state() == ConnectedState, for use in other threads
+    std::atomic<bool> framesReceivedPending = false;
+    std::atomic<bool> droppedFramesReported = false; // until frames are read
+
+    // BlockWhenFull: the producer waits here until the consumer has read frames
+    QMutex producerMutex;
+    QWaitCondition queueNotFull;
+    std::atomic<bool> producerWaiting = false;
+    std::atomic<bool> producerStopped = false; // while a backend joins its receive thread
+
+    // framesReceived() coalescing, configured on connectDevice()
+    qint64 notificationInterval = 0; // microseconds
+    qsizetype notificationThreshold = 0;
+    QChronoTimer *notificationTimer = nullptr;
+    std::atomic<bool> notificationScheduled = false;
+    std::atomic<qint64> notificationCount = 0;
+    std::atomic<qint64> receivedFrameCount = 0;
+
     QList<QCanBusFrame> outgoingFrames;
+    // frames a backend has taken from outgoingFrames, but not written yet
+    qsizetype stagedOutgoingFrames = 0;
     QList<ConfigEntry> configOptions;
 
+    QCanBusFrameFilter frameFilter; // RawFilterKey, for backends without own filtering
+    bool softwareFiltering = false;
+
     bool waitForReceivedEntered = false;
     bool waitForWrittenEntered = false;
 
     std::function<void()> m_resetControllerFunction;
     std::function<QCanBusDevice::CanBusStatus()> m_busStatusGetter;
+    // installed by backends which can write several frames at once, see writeFrames()
+    std::function<qint64(const QList<QCanBusFrame> &)> m_writeFramesFunction;
 };
 
 QT_END_NAMESPACE
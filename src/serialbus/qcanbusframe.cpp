@@ -209,7 +209,21 @@ using namespace Qt::StringLiterals;
 
     Returns the data payload of the frame.
 
-    \sa setPayload()
+    \sa setPayload(), payloadView()
+*/
+
+/*!
+    \fn QByteArrayView QCanBusFrame::payloadView() const
+    \since 6.9
+
+    Returns a view on the data payload of the frame.
+
+    Unlike payload(), this function does not create a copy of the payload
+    container, which makes it the preferred way to inspect the payload of
+    received frames. The view stays valid as long as the frame is neither
+    modified nor destroyed.
+
+    \sa payload(), setPayload()
 */
 
 /*!
@@ -4,6 +4,7 @@
 #ifndef QCANBUSFRAME_H
 #define QCANBUSFRAME_H
 
+#include <QtCore/qbytearrayview.h>
 #include <QtCore/qmetatype.h>
 #include <QtCore/qobject.h>
 #include <QtSerialBus/qtserialbusglobal.h>
@@ -176,6 +177,7 @@ public:
     constexpr void setTimeStamp(TimeStamp ts) noexcept { stamp = ts; }
 
     QByteArray payload() const { return load; }
+    QByteArrayView payloadView() const noexcept { return load; }
     constexpr TimeStamp timeStamp() const noexcept { return stamp; }
 
     constexpr FrameErrors error() const noexcept
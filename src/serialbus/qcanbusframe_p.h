@@ -0,0 +1,92 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCANBUSFRAME_P_H
+#define QCANBUSFRAME_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/private/qglobal_p.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Hands out the payloads of received frames as slices of a larger, shared
+    memory block. This way, a backend does one heap allocation per block
+    instead of one allocation per received frame.
+
+    Each slice shares the block's reference count, so the block is released
+    when the arena and all frames referring to it are gone. Slices are always
+    '\0' terminated like any other QByteArray. Modifying a slice detaches it,
+    because the block is shared.
+
+    A single frame which is kept keeps its whole block alive. The default
+    block size is therefore small: it holds the payloads of one receive batch
+    of classic CAN frames, but a kept frame retains at most 512 bytes instead
+    of its own small allocation. Code which keeps many received frames for a
+    long time while dropping most others can copy the payloads it keeps.
+
+    The arena must only be used from one thread. The resulting QByteArrays
+    can be passed to other threads as usual.
+*/
+class QCanBusFramePayloadArena
+{
+public:
+    explicit QCanBusFramePayloadArena(qsizetype size = DefaultBlockSize)
+        : blockSize(size)
+    {
+    }
+
+    QByteArray payload(const char *data, qsizetype size)
+    {
+        if (size == 0)
+            return QByteArray(data, 0);
+
+        // one additional byte for the terminating '\0'
+        const qsizetype required = size + 1;
+        if (Q_UNLIKELY(block.isNull() || used + required > block.size())) {
+            if (Q_UNLIKELY(required > blockSize))
+                return QByteArray(data, size);
+            block = QByteArray(blockSize, Qt::Uninitialized);
+            used = 0;
+        }
+
+        QByteArray::DataPointer &blockData = block.data_ptr();
+        char *slice = blockData.data() + used;
+        ::memcpy(slice, data, size);
+        slice[size] = '\0';
+        used += required;
+
+        blockData.d_ptr()->ref();
+        return QByteArray(QByteArray::DataPointer(blockData.d_ptr(), slice, size));
+    }
+
+    void clear()
+    {
+        block = QByteArray();
+        used = 0;
+    }
+
+    enum { DefaultBlockSize = 512 };
+
+private:
+    QByteArray block;
+    qsizetype used = 0;
+    qsizetype blockSize;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCANBUSFRAME_P_H
@@ -0,0 +1,119 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcanbusframefilter_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Compiles filters into the lookup tables. An empty list accepts all frames,
+    like an unset QCanBusDevice::RawFilterKey.
+*/
+void QCanBusFrameFilter::setFilters(const QList<Filter> &filters)
+{
+    baseDataFrames.reset();
+    baseRemoteRequestFrames.reset();
+    exactExtendedIds.clear();
+    extendedFilters.clear();
+    allFilters.clear();
+
+    acceptAll = filters.isEmpty();
+    if (acceptAll)
+        return;
+
+    const QList<Filter> mergedFilters = merged(filters);
+    for (const Filter &filter : mergedFilters) {
+        if (filter.type == QCanBusFrame::UnknownFrame)
+            continue; // invalid filter, matches nothing
+
+        allFilters.append(filter);
+
+        if (filter.format & Filter::MatchBaseFormat) {
+            const bool dataFrames = filter.type == QCanBusFrame::InvalidFrame
+                    || filter.type == QCanBusFrame::DataFrame;
+            const bool remoteRequestFrames = filter.type == QCanBusFrame::InvalidFrame
+                    || filter.type == QCanBusFrame::RemoteRequestFrame;
+            const QCanBusFrame::FrameId id = filter.frameId & filter.frameIdMask;
+            for (QCanBusFrame::FrameId candidate = 0; candidate < BaseIdCount; ++candidate) {
+                if ((candidate & filter.frameIdMask) != id)
+                    continue;
+                if (dataFrames)
+                    baseDataFrames.set(candidate);
+                if (remoteRequestFrames)
+                    baseRemoteRequestFrames.set(candidate);
+            }
+        }
+
+        if (filter.format & Filter::MatchExtendedFormat) {
+            if ((filter.frameIdMask & ExtendedIdMask) == ExtendedIdMask)
+                exactExtendedIds[filter.frameId & filter.frameIdMask] |= typeBit(filter.type);
+            else
+                extendedFilters.append(filter);
+        }
+    }
+}
+
+/*
+    Returns true if frame matches filter, as described for
+    QCanBusDevice::Filter.
+*/
+bool QCanBusFrameFilter::matches(const Filter &filter, const QCanBusFrame &frame) noexcept
+{
+    if (filter.type == QCanBusFrame::UnknownFrame)
+        return false;
+    if (filter.type != QCanBusFrame::InvalidFrame && filter.type != frame.frameType())
+        return false;
+
+    const Filter::FormatFilter format = frame.hasExtendedFrameFormat()
+            ? Filter::MatchExtendedFormat : Filter::MatchBaseFormat;
+    if (!(filter.format & format))
+        return false;
+
+    return (frame.frameId() & filter.frameIdMask) == (filter.frameId & filter.frameIdMask);
+}
+
+/*
+    Returns true if filter accepts every frame which is accepted by other.
+*/
+bool QCanBusFrameFilter::covers(const Filter &filter, const Filter &other) noexcept
+{
+    if (filter.type == QCanBusFrame::UnknownFrame)
+        return false;
+    if (filter.type != QCanBusFrame::InvalidFrame && filter.type != other.type)
+        return false;
+    if ((filter.format & other.format) != other.format)
+        return false;
+    // the filter must not compare bits which the other one ignores
+    if (filter.frameIdMask & ~other.frameIdMask)
+        return false;
+
+    return (filter.frameId & filter.frameIdMask) == (other.frameId & filter.frameIdMask);
+}
+
+/*
+    Returns filters without duplicates and without filters, which are
+    covered by another filter of the list. The result accepts the same frames.
+*/
+QList<QCanBusDevice::Filter> QCanBusFrameFilter::merged(const QList<Filter> &filters)
+{
+    QList<Filter> result;
+    result.reserve(filters.size());
+
+    for (const Filter &filter : filters) {
+        const bool covered = std::any_of(result.cbegin(), result.cend(),
+                                         [&filter](const Filter &kept) {
+            return covers(kept, filter);
+        });
+        if (covered)
+            continue;
+
+        result.removeIf([&filter](const Filter &kept) { return covers(filter, kept); });
+        result.append(filter);
+    }
+
+    return result;
+}
+
+QT_END_NAMESPACE
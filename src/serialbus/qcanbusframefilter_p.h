@@ -0,0 +1,107 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCANBUSFRAMEFILTER_P_H
+#define QCANBUSFRAMEFILTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSerialBus/qcanbusdevice.h>
+#include <QtSerialBus/qcanbusframe.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+
+#include <bitset>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Matches received frames against a list of QCanBusDevice::Filter in software,
+    for backends which cannot filter in the driver or the hardware.
+
+    The filter list is compiled into lookup tables: base format data and remote
+    request frames are looked up in a bitmap of all 2048 identifiers, extended
+    format frames in a hash of the filters with a full identifier mask. Only the
+    remaining filters are matched one by one.
+
+    The filter must not be changed while another thread calls accepts().
+*/
+class Q_SERIALBUS_EXPORT QCanBusFrameFilter
+{
+public:
+    using Filter = QCanBusDevice::Filter;
+
+    QCanBusFrameFilter() = default;
+
+    void setFilters(const QList<Filter> &filters);
+    bool acceptsAll() const noexcept { return acceptAll; }
+
+    bool accepts(const QCanBusFrame &frame) const noexcept
+    {
+        if (acceptAll)
+            return true;
+
+        const QCanBusFrame::FrameId id = frame.frameId();
+        if (!frame.hasExtendedFrameFormat() && id < BaseIdCount) {
+            switch (frame.frameType()) {
+            case QCanBusFrame::DataFrame:
+                return baseDataFrames.test(id);
+            case QCanBusFrame::RemoteRequestFrame:
+                return baseRemoteRequestFrames.test(id);
+            default:
+                break;
+            }
+        } else if (frame.hasExtendedFrameFormat()) {
+            const auto exact = exactExtendedIds.constFind(id);
+            if (exact != exactExtendedIds.cend() && (*exact & typeBit(frame.frameType())))
+                return true;
+            for (const Filter &filter : extendedFilters) {
+                if (matches(filter, frame))
+                    return true;
+            }
+            return false;
+        }
+
+        for (const Filter &filter : allFilters) {
+            if (matches(filter, frame))
+                return true;
+        }
+        return false;
+    }
+
+    static bool matches(const Filter &filter, const QCanBusFrame &frame) noexcept;
+    static bool covers(const Filter &filter, const Filter &other) noexcept;
+    static QList<Filter> merged(const QList<Filter> &filters);
+
+private:
+    enum {
+        BaseIdCount = 0x800,
+        ExtendedIdMask = 0x1FFFFFFF
+    };
+
+    static constexpr quint8 typeBit(QCanBusFrame::FrameType type) noexcept
+    {
+        return type == QCanBusFrame::InvalidFrame ? quint8(0xFF) : quint8(1u << type);
+    }
+
+    bool acceptAll = true;
+    std::bitset<BaseIdCount> baseDataFrames;
+    std::bitset<BaseIdCount> baseRemoteRequestFrames;
+    QHash<QCanBusFrame::FrameId, quint8> exactExtendedIds; // frame id -> accepted types
+    QList<Filter> extendedFilters;
+    QList<Filter> allFilters;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCANBUSFRAMEFILTER_P_H
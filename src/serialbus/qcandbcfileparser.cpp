@@ -9,10 +9,22 @@
 #include "private/qcanmessagedescription_p.h"
 #include "private/qcansignaldescription_p.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
-#include <QtCore/QRegularExpression>
-
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+#include <QtCore/QVarLengthArray>
+#if QT_CONFIG(thread)
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#endif
+
+#include <algorithm>
+#include <atomic>
 #include <optional>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,6 +79,22 @@ QT_BEGIN_NAMESPACE
     frameProcessor.setMessageDescriptions(fileParser.messageDescriptions());
     \endcode
 
+    \section2 Precompiled Cache
+
+    Parsing big DBC files can take noticeable time. Use \l saveCache() to
+    store the results of the parsing in a compact binary file, and
+    \l loadCache() to restore them on the next start of the application.
+    The cache stores a hash of the content of the parsed files, so an
+    outdated cache is detected, and the files can be parsed again:
+
+    \code
+    QCanDbcFileParser fileParser;
+    if (!fileParser.loadCache(cacheFileName, fileNames)) {
+        if (fileParser.parse(fileNames))
+            fileParser.saveCache(cacheFileName);
+    }
+    \endcode
+
     \note The parser is stateful, which means that all the results (like
     extracted message descriptions, error code, or warnings) are reset once the
     next parsing starts.
@@ -124,6 +152,40 @@ QT_BEGIN_NAMESPACE
     \sa QCanDbcFileParser::SignalValueDescriptions
 */
 
+/*!
+    \struct QCanDbcFileParser::FileStatistics
+    \inmodule QtSerialBus
+    \since 6.9
+
+    \brief The FileStatistics struct holds the statistics for one parsed file.
+
+    \sa QCanDbcFileParser::fileStatistics()
+*/
+
+/*!
+    \variable QCanDbcFileParser::FileStatistics::fileName
+
+    The name of the file.
+*/
+
+/*!
+    \variable QCanDbcFileParser::FileStatistics::parseTime
+
+    The time spent on reading and parsing the file.
+*/
+
+/*!
+    \variable QCanDbcFileParser::FileStatistics::messageCount
+
+    The number of message descriptions added from the file.
+*/
+
+/*!
+    \variable QCanDbcFileParser::FileStatistics::warningCount
+
+    The number of warnings logged while processing the file.
+*/
+
 /*!
     \enum QCanDbcFileParser::Error
 
@@ -133,6 +195,8 @@ QT_BEGIN_NAMESPACE
     \value None No error occurred.
     \value FileReading An error occurred while opening or reading the file.
     \value Parsing An error occurred while parsing the content of the file.
+    \value [since 6.9] InvalidCache The cache file could not be loaded, because
+            it is missing, corrupted, or outdated. See \l loadCache().
 */
 
 /*!
@@ -170,7 +234,7 @@ QCanDbcFileParser::~QCanDbcFileParser() = default;
 bool QCanDbcFileParser::parse(const QString &fileName)
 {
     d->reset();
-    return d->parseFile(fileName);
+    return d->parseFiles({ fileName });
 }
 
 /*!
@@ -185,6 +249,12 @@ bool QCanDbcFileParser::parse(const QString &fileName)
     The parsing stops at the first error. Call the \l error() and
     \l errorString() methods to get the information about the error.
 
+    Since Qt 6.9 the files are parsed concurrently using a thread pool. The
+    results are merged in the order of \a fileNames, so the extracted message
+    descriptions and the warnings are the same as if the files were parsed
+    one after another. If a file refers to or redefines the messages from the
+    previous files, it is parsed again on top of their results.
+
     Call the \l warnings() method to get the list of warnings that were
     logged during the parsing.
 
@@ -197,11 +267,7 @@ bool QCanDbcFileParser::parse(const QString &fileName)
 bool QCanDbcFileParser::parse(const QStringList &fileNames)
 {
     d->reset();
-    for (const auto &fileName : fileNames) {
-        if (!d->parseFile(fileName))
-            return false;
-    }
-    return true;
+    return d->parseFiles(fileNames);
 }
 
 /*!
@@ -241,6 +307,108 @@ bool QCanDbcFileParser::parseData(QStringView data)
     return d->parseData(data);
 }
 
+/*!
+    \since 6.9
+
+    Parses the next chunk \a data of a DBC file. Returns \c false if an error
+    occurred while parsing the data received so far, or \c true otherwise.
+
+    Use this method together with \l finishFeed() to parse a file while it is
+    being received, for example over a network connection, without keeping
+    all of its content in memory. The \a data is expected to be encoded in
+    UTF-8, and the chunks can be split at arbitrary positions. A leading
+    UTF-8 byte order mark is skipped, like in \l parse(). Every complete
+    line is parsed as soon as it is received.
+
+    The first call after \l parse(), \l parseData(), or \l finishFeed()
+    resets the results of the previous parsing.
+
+    The message descriptions are complete only after \l finishFeed() is
+    called, because the sections which follow the message definitions (like
+    comments, signal types, or extended multiplexing) can still modify any of
+    the messages.
+
+    \code
+    // Whenever the next chunk of the file is received
+    parser.feed(chunk);
+    ...
+    // When the whole file is received
+    if (parser.finishFeed())
+        frameProcessor.updateMessageDescriptions(parser.messageDescriptions());
+    \endcode
+
+    \sa finishFeed(), parseData(), QCanFrameProcessor::updateMessageDescriptions()
+*/
+bool QCanDbcFileParser::feed(QByteArrayView data)
+{
+    if (!d->m_isFeeding) {
+        d->reset();
+        d->m_isFeeding = true;
+    }
+    return d->feed(data);
+}
+
+/*!
+    \since 6.9
+
+    Parses the remaining data received by \l feed(), and completes the
+    message descriptions. Returns \c true if the parsing completed
+    successfully or \c false otherwise.
+
+    After this call, the \l messageDescriptions(), \l messageValueDescriptions(),
+    and \l warnings() methods return the complete results.
+
+    \sa feed()
+*/
+bool QCanDbcFileParser::finishFeed()
+{
+    return d->finishFeed();
+}
+
+/*!
+    \since 6.9
+
+    Saves the results of the last \l parse() call into the binary cache file
+    \a cacheFileName. Returns \c true if the cache was written successfully
+    or \c false otherwise.
+
+    The cache contains the message descriptions, the value descriptions, and
+    the warnings, as well as a hash of the current content of the parsed
+    files. The cache can only be saved if the last \l parse() call completed
+    successfully.
+
+    \sa loadCache(), parse()
+*/
+bool QCanDbcFileParser::saveCache(const QString &cacheFileName) const
+{
+    return d->saveCache(cacheFileName);
+}
+
+/*!
+    \since 6.9
+
+    Loads the results of the parsing from the binary cache file
+    \a cacheFileName, which was previously created with \l saveCache().
+    Returns \c true if the cache was loaded successfully or \c false
+    otherwise.
+
+    The cache is only used if the content of the files \a fileNames is the
+    same as the content of the files which were parsed when the cache was
+    saved. Otherwise, the \l error() method returns
+    \l {QCanDbcFileParser::}{InvalidCache}. In this case call \l parse()
+    to get the up-to-date results, and \l saveCache() to update the cache.
+
+    The cache does not replace the files themselves, as the files are needed
+    to check that the cache is up to date.
+
+    \sa saveCache(), parse()
+*/
+bool QCanDbcFileParser::loadCache(const QString &cacheFileName, const QStringList &fileNames)
+{
+    d->reset();
+    return d->loadCache(cacheFileName, fileNames);
+}
+
 /*!
     Returns the list of message descriptions that were extracted during the
     last \l parse() call.
@@ -308,6 +476,24 @@ QStringList QCanDbcFileParser::warnings() const
     return d->m_warnings;
 }
 
+/*!
+    \since 6.9
+
+    Returns the statistics for each file that was processed during the last
+    \l parse() call, in the order of the processing.
+
+    If the parsing stopped because of an error, the last entry represents the
+    file in which the error occurred.
+
+    The list is empty after a \l parseData() call.
+
+    \sa QCanDbcFileParser::FileStatistics, parse()
+*/
+QList<QCanDbcFileParser::FileStatistics> QCanDbcFileParser::fileStatistics() const
+{
+    return d->m_fileStatistics;
+}
+
 /*!
     Returns a unique identifier description. DBC protocol always uses the
     Frame Id as an identifier, and therefore the unique identifier description
@@ -343,16 +529,311 @@ static constexpr auto kCommentDef = "CM_ "_L1;
 static constexpr auto kExtendedMuxDef = "SG_MUL_VAL_ "_L1;
 static constexpr auto kValDef = "VAL_ "_L1;
 
-static constexpr auto kUnsignedIntRegExp = "\\d+"_L1;
-static constexpr auto kDoubleRegExp = "[+-]?\\d+((.\\d*)?([eE][+-]?\\d+)?)?"_L1;
-static constexpr auto kDbcIdentRegExp = "[_[:alpha:]][_[:alnum:]]+"_L1;
-static constexpr auto kOneOrMoreSpaceRegExp = "[ ]+"_L1;
-static constexpr auto kMaybeSpaceRegExp = "[ ]*"_L1;
-static constexpr auto kMuxIndicatorRegExp = "M|m\\d+M?"_L1;
-static constexpr auto kByteOrderRegExp = "0|1"_L1;
-static constexpr auto kValueTypeRegExp = "\\+|\\-"_L1;
-// The pattern matches all printable characters, except double-quote (") and backslash (\).
-static constexpr auto kCharStrRegExp = "((?![\\\"\\\\])\\P{Cc})*"_L1;
+namespace {
+
+// The files are parsed directly from their UTF-8 encoded content, while
+// parseData() receives UTF-16 data. The following helpers allow to use the
+// same parsing code for both QByteArrayView and QStringView.
+
+QByteArrayView asBytes(QLatin1StringView str)
+{
+    return QByteArrayView(str.data(), str.size());
+}
+
+QString toString(QStringView str)
+{
+    return str.toString();
+}
+
+QString toString(QByteArrayView str)
+{
+    return QString::fromUtf8(str);
+}
+
+// Returns the copy of \a str that is stored in \a pool, so that all equal
+// strings share the same data.
+QString internString(QSet<QString> &pool, QString &&str)
+{
+    const auto it = pool.constFind(str);
+    if (it != pool.cend())
+        return *it;
+    pool.insert(str);
+    return std::move(str);
+}
+
+qsizetype indexOf(QStringView str, QLatin1StringView needle, qsizetype from = 0)
+{
+    return str.indexOf(needle, from);
+}
+
+qsizetype indexOf(QByteArrayView str, QLatin1StringView needle, qsizetype from = 0)
+{
+    return str.indexOf(asBytes(needle), from);
+}
+
+bool startsWith(QStringView str, QLatin1StringView prefix)
+{
+    return str.startsWith(prefix);
+}
+
+bool startsWith(QByteArrayView str, QLatin1StringView prefix)
+{
+    return str.startsWith(asBytes(prefix));
+}
+
+bool equals(QStringView str, QLatin1StringView other)
+{
+    return str == other;
+}
+
+bool equals(QByteArrayView str, QLatin1StringView other)
+{
+    return str == asBytes(other);
+}
+
+char16_t codeUnit(QStringView str, qsizetype pos)
+{
+    return str[pos].unicode();
+}
+
+char16_t codeUnit(QByteArrayView str, qsizetype pos)
+{
+    return uchar(str[pos]);
+}
+
+// Returns the code point at \a pos, and its length in code units in \a size.
+// Malformed data is returned as QChar::ReplacementCharacter.
+char32_t codePoint(QStringView str, qsizetype pos, qsizetype *size)
+{
+    *size = 1;
+    if (str[pos].isHighSurrogate() && pos + 1 < str.size() && str[pos + 1].isLowSurrogate()) {
+        *size = 2;
+        return QChar::surrogateToUcs4(str[pos], str[pos + 1]);
+    }
+    return str[pos].unicode();
+}
+
+char32_t codePoint(QByteArrayView str, qsizetype pos, qsizetype *size)
+{
+    *size = 1;
+    const uchar lead = uchar(str[pos]);
+    if (lead < 0x80)
+        return lead;
+
+    qsizetype length = 0;
+    char32_t ch = 0;
+    char32_t minValue = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        ch = lead & 0x1F;
+        minValue = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        ch = lead & 0x0F;
+        minValue = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        ch = lead & 0x07;
+        minValue = 0x10000;
+    } else {
+        return QChar::ReplacementCharacter;
+    }
+    if (pos + length > str.size())
+        return QChar::ReplacementCharacter;
+    for (qsizetype i = 1; i < length; ++i) {
+        const uchar next = uchar(str[pos + i]);
+        if ((next & 0xC0) != 0x80)
+            return QChar::ReplacementCharacter;
+        ch = (ch << 6) | (next & 0x3F);
+    }
+    if (ch < minValue || ch > QChar::LastValidCodePoint || QChar::isSurrogate(ch))
+        return QChar::ReplacementCharacter;
+    *size = length;
+    return ch;
+}
+
+// Reads the tokens of the DBC grammar from one line of the file.
+//
+// Each method tries to read one token at the current position. On success it
+// moves the position behind the token, otherwise the position is unchanged.
+// Like in the DBC specification, only the space character separates tokens.
+template <typename View>
+class DbcLineReader
+{
+public:
+    DbcLineReader(View line, qsizetype position) : m_line(line), m_pos(position) {}
+
+    qsizetype position() const { return m_pos; }
+    void setPosition(qsizetype position) { m_pos = position; }
+
+    void skipSpaces()
+    {
+        while (m_pos < m_line.size() && codeUnit(m_line, m_pos) == u' ')
+            ++m_pos;
+    }
+
+    bool spaces()
+    {
+        const qsizetype start = m_pos;
+        skipSpaces();
+        return m_pos != start;
+    }
+
+    bool character(char16_t ch)
+    {
+        if (m_pos == m_line.size() || codeUnit(m_line, m_pos) != ch)
+            return false;
+        ++m_pos;
+        return true;
+    }
+
+    bool oneOf(QLatin1StringView chars, View *token)
+    {
+        if (m_pos == m_line.size() || !chars.contains(QChar(codeUnit(m_line, m_pos))))
+            return false;
+        *token = m_line.sliced(m_pos++, 1);
+        return true;
+    }
+
+    bool keyword(QLatin1StringView keyword, View *token)
+    {
+        if (!startsWith(m_line.sliced(m_pos), keyword))
+            return false;
+        *token = m_line.sliced(m_pos, keyword.size());
+        m_pos += keyword.size();
+        return true;
+    }
+
+    // unsigned_integer: one or more decimal digits
+    bool unsignedInt(View *token)
+    {
+        const qsizetype start = m_pos;
+        while (consumeIf([](char32_t ch) { return QChar::isDigit(ch); })) {
+        }
+        return capture(start, token);
+    }
+
+    // double: [+-]digits[.digits][(e|E)[+-]digits]
+    bool number(View *token)
+    {
+        const qsizetype start = m_pos;
+        View part;
+        if (!character(u'+'))
+            character(u'-');
+        if (!unsignedInt(&part)) {
+            m_pos = start;
+            return false;
+        }
+        if (character(u'.'))
+            unsignedInt(&part);
+        const qsizetype mantissaEnd = m_pos;
+        if (character(u'e') || character(u'E')) {
+            if (!character(u'+'))
+                character(u'-');
+            if (!unsignedInt(&part))
+                m_pos = mantissaEnd;
+        }
+        return capture(start, token);
+    }
+
+    // DBC_identifier: a letter or underscore, followed by at least one
+    // letter, digit or underscore
+    bool identifier(View *token)
+    {
+        const qsizetype start = m_pos;
+        if (!consumeIf([](char32_t ch) { return ch == U'_' || QChar::isLetter(ch); }))
+            return false;
+        qsizetype length = 1;
+        while (consumeIf([](char32_t ch) { return ch == U'_' || QChar::isLetterOrNumber(ch); }))
+            ++length;
+        if (length < 2) {
+            m_pos = start;
+            return false;
+        }
+        return capture(start, token);
+    }
+
+    // char_string: printable characters except double quote and backslash,
+    // enclosed in double quotes. The token does not include the quotes.
+    bool charString(View *token)
+    {
+        const qsizetype start = m_pos;
+        if (!character(u'"'))
+            return false;
+        while (m_pos < m_line.size()) {
+            if (character(u'"')) {
+                *token = m_line.sliced(start + 1, m_pos - start - 2);
+                return true;
+            }
+            if (!consumeIf([](char32_t ch) {
+                    return ch != U'\\' && QChar::category(ch) != QChar::Other_Control;
+                })) {
+                break;
+            }
+        }
+        m_pos = start;
+        return false;
+    }
+
+    // multiplexer_indicator: M, or m followed by the switch value and an
+    // optional M
+    bool multiplexerIndicator(View *token)
+    {
+        const qsizetype start = m_pos;
+        if (character(u'M'))
+            return capture(start, token);
+        View value;
+        if (!character(u'm') || !unsignedInt(&value)) {
+            m_pos = start;
+            return false;
+        }
+        character(u'M');
+        return capture(start, token);
+    }
+
+private:
+    bool capture(qsizetype start, View *token)
+    {
+        if (m_pos == start)
+            return false;
+        *token = m_line.sliced(start, m_pos - start);
+        return true;
+    }
+
+    template <typename Predicate>
+    bool consumeIf(Predicate predicate)
+    {
+        if (m_pos == m_line.size())
+            return false;
+        qsizetype size = 1;
+        if (!predicate(codePoint(m_line, m_pos, &size)))
+            return false;
+        m_pos += size;
+        return true;
+    }
+
+    View m_line;
+    qsizetype m_pos = 0;
+};
+
+} // unnamed namespace
+
+// Searches for the definition starting with \a keyword in \a data, and reads
+// it with \a readDefinition. Returns the end position of the definition, or
+// -1 if it is not found.
+// Usually the line starts with the definition, but we also accept it after
+// some leading garbage.
+template <typename View, typename Reader>
+static qsizetype findDefinition(View data, QLatin1StringView keyword, Reader readDefinition)
+{
+    for (qsizetype from = indexOf(data, keyword); from != -1;
+         from = indexOf(data, keyword, from + 1)) {
+        DbcLineReader<View> reader(data, from + keyword.size());
+        if (readDefinition(reader))
+            return reader.position();
+    }
+    return -1;
+}
 
 void QCanDbcFileParserPrivate::reset()
 {
@@ -366,12 +847,106 @@ void QCanDbcFileParserPrivate::reset()
     m_currentMessage = {};
     m_messageDescriptions.clear();
     m_valueDescriptions.clear();
+    m_parsedFileNames.clear();
+    m_pendingData.clear();
+    m_isFeeding = false;
+    m_feedStarted = false;
+    m_fileStatistics.clear();
+    m_definedUniqueIds.clear();
+    m_hasUnresolvedReferences = false;
+    m_stringPool.clear();
+}
+
+/*!
+    \internal
+    Parses the files concurrently, each of them with a separate parser, and
+    merges the results in the order of \a fileNames.
+
+    A file can refer to the messages from the previous files, or define the
+    same unique ids. In such cases the result of the separate parsing is
+    different, so the file is parsed once again on top of the merged results,
+    the same way as it happens in the sequential case.
+*/
+bool QCanDbcFileParserPrivate::parseFiles(const QStringList &fileNames)
+{
+    m_parsedFileNames = fileNames;
+    const qsizetype count = fileNames.size();
+    std::vector<QCanDbcFileParserPrivate> parsers;
+    std::vector<std::chrono::nanoseconds> parseTimes(count);
+
+#if QT_CONFIG(thread)
+    if (count > 1) {
+        parsers.resize(count);
+        std::atomic<qsizetype> nextFile = 0;
+        auto parseRemainingFiles = [&] {
+            for (qsizetype i = nextFile++; i < count; i = nextFile++) {
+                QElapsedTimer timer;
+                timer.start();
+                parsers[i].parseFile(fileNames[i]);
+                parseTimes[i] = timer.durationElapsed();
+            }
+        };
+        // A separate pool, so that we never wait for the tasks of others.
+        // The calling thread parses the files as well.
+        QThreadPool pool;
+        const qsizetype workerCount = qMin<qsizetype>(QThread::idealThreadCount(), count) - 1;
+        for (qsizetype i = 0; i < workerCount; ++i)
+            pool.start(parseRemainingFiles);
+        parseRemainingFiles();
+        pool.waitForDone();
+    }
+#endif
+
+    for (qsizetype i = 0; i < count; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        const qsizetype messagesBefore = m_messageDescriptions.size();
+        const qsizetype warningsBefore = m_warnings.size();
+
+        bool result = true;
+        if (!parsers.empty() && canMerge(parsers[i]))
+            merge(std::move(parsers[i]));
+        else
+            result = parseFile(fileNames[i]); // also sets the error properly
+
+        m_fileStatistics.push_back({ fileNames[i], parseTimes[i] + timer.durationElapsed(),
+                                     m_messageDescriptions.size() - messagesBefore,
+                                     m_warnings.size() - warningsBefore });
+        if (!result)
+            return false;
+    }
+    return true;
+}
+
+bool QCanDbcFileParserPrivate::canMerge(const QCanDbcFileParserPrivate &other) const
+{
+    // In case of error, parse once again to get the same partial results
+    if (other.m_error != QCanDbcFileParser::Error::None || other.m_hasUnresolvedReferences)
+        return false;
+    return std::none_of(other.m_definedUniqueIds.cbegin(), other.m_definedUniqueIds.cend(),
+                        [this](QtCanBus::UniqueId uid) {
+        return m_messageDescriptions.contains(uid);
+    });
+}
+
+void QCanDbcFileParserPrivate::merge(QCanDbcFileParserPrivate &&other)
+{
+    m_fileName = std::move(other.m_fileName);
+    m_warnings.append(std::move(other.m_warnings));
+    // canMerge() guarantees that the unique ids are not used yet
+    m_messageDescriptions.insert(other.m_messageDescriptions);
+    m_valueDescriptions.insert(other.m_valueDescriptions);
+    m_definedUniqueIds.append(other.m_definedUniqueIds);
 }
 
 /*!
     \internal
     Returns \c false only in case of hard error. Returns \c true even if some
     warnings occurred during parsing.
+
+    The file is memory-mapped when possible, and parsed directly from its
+    UTF-8 encoded content. Only the strings which are stored in the resulting
+    descriptions (or used in the warnings) are converted to QString.
 */
 bool QCanDbcFileParserPrivate::parseFile(const QString &fileName)
 {
@@ -382,38 +957,47 @@ bool QCanDbcFileParserPrivate::parseFile(const QString &fileName)
         return false;
     }
     m_fileName = fileName;
-    m_seenExtraData = false;
-
-    while (!f.atEnd()) {
-        const QString str = QString::fromUtf8(f.readLine().trimmed());
-        if (!processLine({str.constData(), str.size()})) // also sets the error properly
-            return false;
-    }
-    addCurrentMessage(); // check if we need to add the message
-    // now when we parsed the whole file, we can verify the signal multiplexing
-    postProcessSignalMultiplexing();
 
-    return true;
+    // Some files (e.g. the ones from the compressed resources) cannot be
+    // mapped, so fall back to reading all the content in that case.
+    QByteArray content;
+    const qint64 size = f.size();
+    uchar *mapped = size > 0 ? f.map(0, size) : nullptr;
+    if (!mapped)
+        content = f.readAll();
+    QByteArrayView data = mapped ? QByteArrayView(mapped, qsizetype(size))
+                                 : QByteArrayView(content);
+    if (data.startsWith("\xEF\xBB\xBF")) // UTF-8 BOM
+        data = data.sliced(3);
+
+    const bool result = parseLines(data);
+    if (mapped)
+        f.unmap(mapped);
+    return result;
 }
 
+template <typename View>
 struct ReadData
 {
     qsizetype index;
-    QStringView result;
+    View result;
 };
 
-static ReadData readUntilNewline(QStringView in, qsizetype from)
+// Note that QByteArrayView::trimmed() removes only the ASCII whitespaces,
+// which matches the behavior of QFile::readLine().trimmed().
+template <typename View>
+static ReadData<View> readUntilNewline(View in, qsizetype from)
 {
-    const qsizetype idx = in.indexOf('\n'_L1, from);
+    const qsizetype idx = indexOf(in, "\n"_L1, from);
 
-    return (idx == -1) ? ReadData{idx, in.sliced(from).trimmed()}
-                       : ReadData{idx, in.sliced(from, idx - from).trimmed()};
+    return (idx == -1) ? ReadData<View>{idx, in.sliced(from).trimmed()}
+                       : ReadData<View>{idx, in.sliced(from, idx - from).trimmed()};
 }
 
 /*!
     \internal
-    The implementation basically copies parseFile(), including all
-    post-processing. The only difference is in extracting the data.
+    The parsing of the file content is shared with parseFile(), including all
+    post-processing. The only difference is the encoding of the data.
 */
 bool QCanDbcFileParserPrivate::parseData(QStringView data)
 {
@@ -422,16 +1006,98 @@ bool QCanDbcFileParserPrivate::parseData(QStringView data)
         m_errorString = QObject::tr("Empty input data.");
         return false;
     }
+    return parseLines(data);
+}
+
+/*!
+    \internal
+    Parses the complete content of a file or input data.
+    Returns \c false only in case of hard error.
+*/
+template <typename View>
+bool QCanDbcFileParserPrivate::parseLines(View data)
+{
     m_seenExtraData = false;
+    if (!processLines(data))
+        return false;
+    addCurrentMessage(); // check if we need to add the message
+    // now when we parsed the whole data, we can verify the signal multiplexing
+    postProcessSignalMultiplexing();
+    return true;
+}
+
+/*!
+    \internal
+    Splits \a data into lines and processes them one by one.
+    Returns \c false only in case of hard error.
+*/
+template <typename View>
+bool QCanDbcFileParserPrivate::processLines(View data)
+{
     qsizetype from = 0;
     while (true) {
         const auto [idx, sv] = readUntilNewline(data, from);
-        if (!processLine(sv))
+        if (!processLine(sv)) // also sets the error properly
             return false;
-        if (idx == -1) // reached the end of the string
+        if (idx == -1) // reached the end of the data
             break;
         from = idx + 1;
     }
+    return true;
+}
+
+/*!
+    \internal
+    Processes all complete lines of \a data, and keeps the incomplete last
+    line until the next chunk arrives.
+*/
+bool QCanDbcFileParserPrivate::feed(QByteArrayView data)
+{
+    if (m_error != QCanDbcFileParser::Error::None)
+        return false;
+
+    if (Q_UNLIKELY(!m_feedStarted)) {
+        // skip the UTF-8 BOM like parseFile() does, it might be split across chunks
+        constexpr QByteArrayView bom("\xEF\xBB\xBF");
+        m_pendingData.append(data);
+        if (m_pendingData.size() < bom.size() && bom.startsWith(m_pendingData))
+            return true;
+
+        m_feedStarted = true;
+        QByteArray start = std::exchange(m_pendingData, {});
+        if (start.startsWith(bom))
+            start.remove(0, bom.size());
+        return feed(start);
+    }
+
+    const qsizetype lastNewline = data.lastIndexOf('\n');
+    if (lastNewline == -1) {
+        m_pendingData.append(data);
+        return true;
+    }
+
+    bool result = true;
+    if (m_pendingData.isEmpty()) {
+        result = processLines(data.first(lastNewline));
+    } else {
+        m_pendingData.append(data.first(lastNewline));
+        result = processLines(QByteArrayView(m_pendingData));
+        m_pendingData.clear();
+    }
+    if (result)
+        m_pendingData.append(data.sliced(lastNewline + 1));
+    return result;
+}
+
+bool QCanDbcFileParserPrivate::finishFeed()
+{
+    m_isFeeding = false;
+    if (m_error != QCanDbcFileParser::Error::None)
+        return false;
+
+    const QByteArray lastLine = std::exchange(m_pendingData, {});
+    if (!processLine(QByteArrayView(lastLine).trimmed()))
+        return false;
     addCurrentMessage();
     postProcessSignalMultiplexing();
     return true;
@@ -442,9 +1108,10 @@ bool QCanDbcFileParserPrivate::parseData(QStringView data)
     Returns \c false only in case of hard error. Returns \c true even if some
     warnings occurred during parsing.
 */
-bool QCanDbcFileParserPrivate::processLine(const QStringView line)
+template <typename View>
+bool QCanDbcFileParserPrivate::processLine(const View line)
 {
-    QStringView data = line;
+    View data = line;
     m_lineOffset = 0;
 
     auto handleParsingError = [this](QLatin1StringView section) {
@@ -456,7 +1123,7 @@ bool QCanDbcFileParserPrivate::processLine(const QStringView line)
                               "of %1 section.").arg(section);
     };
 
-    if (data.startsWith(kMessageDef)) {
+    if (startsWith(data, kMessageDef)) {
         if (m_seenExtraData) {
             // Unexpected position of message description
             handleParsingError(kMessageDef);
@@ -469,7 +1136,7 @@ bool QCanDbcFileParserPrivate::processLine(const QStringView line)
     // signal definitions can be on the same line as message definition,
     // or on a separate line
     data = data.sliced(m_lineOffset).trimmed();
-    while (data.startsWith(kSignalDef)) {
+    while (startsWith(data, kSignalDef)) {
         if (!m_isProcessingMessage || m_seenExtraData) {
             // Unexpected position of signal description
             handleParsingError(kSignalDef);
@@ -481,19 +1148,19 @@ bool QCanDbcFileParserPrivate::processLine(const QStringView line)
     }
     // If we detect one of the following lines, then message description is
     // finished. We also assume that we can have only one key at each line.
-    if (data.startsWith(kSigValTypeDef)) {
+    if (startsWith(data, kSigValTypeDef)) {
         m_seenExtraData = true;
         addCurrentMessage();
         parseSignalType(data);
-    } else if (data.startsWith(kCommentDef)) {
+    } else if (startsWith(data, kCommentDef)) {
         m_seenExtraData = true;
         addCurrentMessage();
         parseComment(data);
-    } else if (data.startsWith(kExtendedMuxDef)) {
+    } else if (startsWith(data, kExtendedMuxDef)) {
         m_seenExtraData = true;
         addCurrentMessage();
         parseExtendedMux(data);
-    } else if (data.startsWith(kValDef)) {
+    } else if (startsWith(data, kValDef)) {
         m_seenExtraData = true;
         addCurrentMessage();
         parseValueDescriptions(data);
@@ -501,7 +1168,8 @@ bool QCanDbcFileParserPrivate::processLine(const QStringView line)
     return true;
 }
 
-static std::optional<QtCanBus::UniqueId> extractUniqueId(QStringView view)
+template <typename View>
+static std::optional<QtCanBus::UniqueId> extractUniqueId(View view)
 {
     bool ok = false;
     const uint value = view.toUInt(&ok);
@@ -515,51 +1183,67 @@ static std::optional<QtCanBus::UniqueId> extractUniqueId(QStringView view)
     Returns \c false only in case of hard error. Returns \c true even if some
     warnings occurred during parsing.
 */
-bool QCanDbcFileParserPrivate::parseMessage(const QStringView data)
+template <typename View>
+bool QCanDbcFileParserPrivate::parseMessage(const View data)
 {
-    // The regexp matches the following definition:
+    // The message description has the following definition:
     // BO_ message_id message_name ':' message_size transmitter
     // also considering the fact that spaces around ':' seem to be optional, and
     // allowing more than one space between parts.
-
-    // %1 - messageDef
-    // %2 - maybeSpace
-    // %3 - unsignedInt
-    // %4 - oneOrMoreSpace
-    // %5 - DbcIdentifier
-    static const QString regExStr =
-            "%1%2(?<messageId>%3)%4(?<name>%5)%2:%2(?<size>%3)%4(?<transmitter>%5)"_L1.
-            arg(kMessageDef, kMaybeSpaceRegExp, kUnsignedIntRegExp, kOneOrMoreSpaceRegExp,
-                kDbcIdentRegExp);
-    static const QRegularExpression messageRegExp(regExStr);
+    MessageTokens<View> tokens;
+    const qsizetype end = findDefinition(data, kMessageDef, [&tokens](DbcLineReader<View> &in) {
+        tokens = {};
+        in.skipSpaces();
+        if (!in.unsignedInt(&tokens.messageId) || !in.spaces() || !in.identifier(&tokens.name))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u':'))
+            return false;
+        in.skipSpaces();
+        return in.unsignedInt(&tokens.size) && in.spaces()
+                && in.identifier(&tokens.transmitter);
+    });
 
     m_isProcessingMessage = false;
-    const auto match = messageRegExp.matchView(data);
-    if (match.hasMatch()) {
-        m_currentMessage = extractMessage(match);
+    if (end != -1) {
+        m_currentMessage = extractMessage(tokens);
         // can't check for isValid() here, because demands signal descriptions
         if (!m_currentMessage.name().isEmpty()) {
             m_isProcessingMessage = true;
         } else {
             addWarning(QObject::tr("Failed to parse message description from "
-                                   "string %1").arg(data));
+                                   "string %1").arg(toString(data)));
         }
-        m_lineOffset = match.capturedEnd(0);
+        m_lineOffset = end;
     } else {
-        addWarning(QObject::tr("Failed to find message description in string %1").arg(data));
+        addWarning(QObject::tr("Failed to find message description in string %1").
+                   arg(toString(data)));
         m_lineOffset = data.size(); // skip this string
     }
     return true;
 }
 
+/*!
+    \internal
+    Returns a string with the content of \a str, which shares its data with
+    all the other equal strings interned by this parser. Signal names, units,
+    receivers and value descriptions are repeated many times in a typical
+    database, so this saves a lot of small allocations in the results.
+*/
+template <typename View>
+QString QCanDbcFileParserPrivate::intern(View str)
+{
+    return internString(m_stringPool, toString(str));
+}
+
+template <typename View>
 QCanMessageDescription
-QCanDbcFileParserPrivate::extractMessage(const QRegularExpressionMatch &match)
+QCanDbcFileParserPrivate::extractMessage(const MessageTokens<View> &tokens)
 {
-    Q_ASSERT(match.hasMatch());
     QCanMessageDescription desc;
-    desc.setName(match.captured(u"name"_s));
+    desc.setName(toString(tokens.name));
 
-    const auto id = extractUniqueId(match.capturedView(u"messageId"_s));
+    const auto id = extractUniqueId(tokens.messageId);
     if (id.has_value()) {
         desc.setUniqueId(id.value());
     } else {
@@ -568,7 +1252,7 @@ QCanDbcFileParserPrivate::extractMessage(const QRegularExpressionMatch &match)
     }
 
     bool ok = false;
-    const auto size = match.capturedView(u"size"_s).toUInt(&ok);
+    const auto size = tokens.size.toUInt(&ok);
     if (ok) {
         desc.setSize(size);
     } else {
@@ -576,7 +1260,7 @@ QCanDbcFileParserPrivate::extractMessage(const QRegularExpressionMatch &match)
         return {};
     }
 
-    desc.setTransmitter(match.captured(u"transmitter"_s));
+    desc.setTransmitter(intern(tokens.transmitter));
 
     return desc;
 }
@@ -586,68 +1270,125 @@ QCanDbcFileParserPrivate::extractMessage(const QRegularExpressionMatch &match)
     Returns \c false only in case of hard error. Returns \c true even if some
     warnings occurred during parsing.
 */
-bool QCanDbcFileParserPrivate::parseSignal(const QStringView data)
+template <typename View>
+bool QCanDbcFileParserPrivate::parseSignal(const View data)
 {
-    // The regexp should match the following pattern:
+    // The signal description has the following definition:
     //      SG_ signal_name multiplexer_indicator : start_bit |
     //      signal_size @ byte_order value_type ( factor , offset )
     //      [ minimum | maximum ] unit receiver {, receiver}
     // We also need to consider the fact that some of the spaces might be
     // optional, and we can potentially allow more spaces between parts.
     // Note that the end of the signal description can contain multiple
-    // receivers. The regexp is supposed to extract all of them, but we use
-    // only the first one for now.
-
-    // %1 - SignalDef
-    // %2 - MaybeSpace
-    // %3 - DbcIdentifier
-    // %4 - OneOrMoreSpace
-    // %5 - MuxIndicator
-    // %6 - unsignedInt
-    // %7 - byteOrder
-    // %8 - valueType
-    // %9 - double
-    // %10 - charStr
-    static const QString regExStr =
-            "%1%2(?<name>%3)(%4(?<mux>%5))?%2:%2(?<startBit>%6)%2\\|%2(?<sigSize>%6)%2@%2"
-            "(?<byteOrder>%7)%2(?<valueType>%8)%4\\(%2(?<factor>%9)%2,%2(?<offset>%9)%2\\)"
-            "%4\\[%2(?<min>%9)%2\\|%2(?<max>%9)%2\\]%4\"(?<unit>%10)\""
-            "%4(?<receiver>%3)(%2,%2%3)*"_L1.
-            arg(kSignalDef, kMaybeSpaceRegExp, kDbcIdentRegExp, kOneOrMoreSpaceRegExp,
-                kMuxIndicatorRegExp, kUnsignedIntRegExp, kByteOrderRegExp, kValueTypeRegExp,
-                kDoubleRegExp, kCharStrRegExp);
-    static const QRegularExpression signalRegExp(regExStr);
-
-    const auto match = signalRegExp.matchView(data);
-    if (match.hasMatch()) {
-        QCanSignalDescription desc = extractSignal(match);
+    // receivers. The reader skips all of them, but we use only the first one
+    // for now.
+    SignalTokens<View> tokens;
+    const qsizetype end = findDefinition(data, kSignalDef, [&tokens](DbcLineReader<View> &in) {
+        tokens = {};
+        in.skipSpaces();
+        if (!in.identifier(&tokens.name))
+            return false;
+        const qsizetype nameEnd = in.position();
+        if (!in.spaces() || !in.multiplexerIndicator(&tokens.mux)) {
+            in.setPosition(nameEnd);
+            tokens.mux = {};
+        }
+        in.skipSpaces();
+        if (!in.character(u':'))
+            return false;
+        in.skipSpaces();
+        if (!in.unsignedInt(&tokens.startBit))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u'|'))
+            return false;
+        in.skipSpaces();
+        if (!in.unsignedInt(&tokens.sigSize))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u'@'))
+            return false;
+        in.skipSpaces();
+        if (!in.oneOf("01"_L1, &tokens.byteOrder))
+            return false;
+        in.skipSpaces();
+        if (!in.oneOf("+-"_L1, &tokens.valueType) || !in.spaces() || !in.character(u'('))
+            return false;
+        in.skipSpaces();
+        if (!in.number(&tokens.factor))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u','))
+            return false;
+        in.skipSpaces();
+        if (!in.number(&tokens.offset))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u')') || !in.spaces() || !in.character(u'['))
+            return false;
+        in.skipSpaces();
+        if (!in.number(&tokens.min))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u'|'))
+            return false;
+        in.skipSpaces();
+        if (!in.number(&tokens.max))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u']') || !in.spaces() || !in.charString(&tokens.unit)
+                || !in.spaces() || !in.identifier(&tokens.receiver)) {
+            return false;
+        }
+        while (true) {
+            const qsizetype receiverEnd = in.position();
+            View receiver;
+            in.skipSpaces();
+            if (!in.character(u',')) {
+                in.setPosition(receiverEnd);
+                break;
+            }
+            in.skipSpaces();
+            if (!in.identifier(&receiver)) {
+                in.setPosition(receiverEnd);
+                break;
+            }
+        }
+        return true;
+    });
+
+    if (end != -1) {
+        QCanSignalDescription desc = extractSignal(tokens);
 
         if (desc.isValid())
             m_currentMessage.addSignalDescription(desc);
         else
-            addWarning(QObject::tr("Failed to parse signal description from string %1").arg(data));
+            addWarning(QObject::tr("Failed to parse signal description from string %1").
+                       arg(toString(data)));
 
-        m_lineOffset = match.capturedEnd(0);
+        m_lineOffset = end;
     } else {
-        addWarning(QObject::tr("Failed to find signal description in string %1").arg(data));
+        addWarning(QObject::tr("Failed to find signal description in string %1").
+                   arg(toString(data)));
         m_lineOffset = data.size(); // skip this string
     }
     return true;
 }
 
-QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpressionMatch &match)
+template <typename View>
+QCanSignalDescription
+QCanDbcFileParserPrivate::extractSignal(const SignalTokens<View> &tokens)
 {
-    Q_ASSERT(match.hasMatch());
     QCanSignalDescription desc;
-    desc.setName(match.captured(u"name"_s));
+    desc.setName(intern(tokens.name));
 
     bool ok = false;
 
-    if (match.hasCaptured(u"mux"_s)) {
-        const auto muxStr = match.capturedView(u"mux"_s);
-        if (muxStr == u"M"_s) {
+    if (!tokens.mux.isEmpty()) {
+        const auto muxStr = tokens.mux;
+        if (equals(muxStr, "M"_L1)) {
             desc.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
-        } else if (muxStr.endsWith(u"M"_s, Qt::CaseSensitive)) {
+        } else if (codeUnit(muxStr, muxStr.size() - 1) == u'M') {
             desc.setMultiplexState(QtCanBus::MultiplexState::SwitchAndSignal);
             const auto val = muxStr.sliced(1, muxStr.size() - 2).toUInt(&ok);
             if (!ok) {
@@ -673,7 +1414,7 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
         }
     }
 
-    const uint startBit = match.capturedView(u"startBit"_s).toUInt(&ok);
+    const uint startBit = tokens.startBit.toUInt(&ok);
     if (ok) {
         desc.setStartBit(startBit);
     } else {
@@ -681,7 +1422,7 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
         return {};
     }
 
-    const uint bitLength = match.capturedView(u"sigSize"_s).toUInt(&ok);
+    const uint bitLength = tokens.sigSize.toUInt(&ok);
     if (ok) {
         desc.setBitLength(bitLength);
     } else {
@@ -690,16 +1431,16 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
     }
 
     // 0 = BE; 1 = LE
-    const auto endian = match.capturedView(u"byteOrder"_s) == u"0"_s
+    const auto endian = equals(tokens.byteOrder, "0"_L1)
             ? QSysInfo::Endian::BigEndian : QSysInfo::Endian::LittleEndian;
     desc.setDataEndian(endian);
 
     // + = unsigned; - = signed
-    const auto dataFormat = match.capturedView(u"valueType"_s) == u"+"_s
+    const auto dataFormat = equals(tokens.valueType, "+"_L1)
             ? QtCanBus::DataFormat::UnsignedInteger : QtCanBus::DataFormat::SignedInteger;
     desc.setDataFormat(dataFormat);
 
-    const double factor = match.capturedView(u"factor"_s).toDouble(&ok);
+    const double factor = tokens.factor.toDouble(&ok);
     if (ok) {
         desc.setFactor(factor);
     } else {
@@ -707,7 +1448,7 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
         return {};
     }
 
-    const double offset = match.capturedView(u"offset"_s).toDouble(&ok);
+    const double offset = tokens.offset.toDouble(&ok);
     if (ok) {
         desc.setOffset(offset);
     } else {
@@ -715,9 +1456,9 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
         return {};
     }
 
-    const double min = match.capturedView(u"min"_s).toDouble(&ok);
+    const double min = tokens.min.toDouble(&ok);
     if (ok) {
-        const double max = match.capturedView(u"max"_s).toDouble(&ok);
+        const double max = tokens.max.toDouble(&ok);
         if (ok)
             desc.setRange(min, max);
     }
@@ -726,54 +1467,58 @@ QCanSignalDescription QCanDbcFileParserPrivate::extractSignal(const QRegularExpr
         return {};
     }
 
-    desc.setPhysicalUnit(match.captured(u"unit"_s));
-    desc.setReceiver(match.captured(u"receiver"_s));
+    desc.setPhysicalUnit(intern(tokens.unit));
+    desc.setReceiver(intern(tokens.receiver));
 
     return desc;
 }
 
-void QCanDbcFileParserPrivate::parseSignalType(const QStringView data)
+template <typename View>
+void QCanDbcFileParserPrivate::parseSignalType(const View data)
 {
-    // The regexp should match the following pattern:
+    // The signal type description has the following definition:
     //      SIG_VALTYPE_ message_id signal_name signal_extended_value_type ;
     // We also need to consider the fact that we can potentially allow more
     // spaces between parts.
-
-    // %1 sigValTypeDef
-    // %2 maybeSpace
-    // %3 unsignedInt
-    // %4 oneOrMoreSpace
-    // %5 DbcIdentifier
-    const QString regExStr =
-            "%1%2(?<messageId>%3)%4(?<sigName>%5)%2:%2(?<type>%3)%2;"_L1.
-            arg(kSigValTypeDef, kMaybeSpaceRegExp, kUnsignedIntRegExp,
-                kOneOrMoreSpaceRegExp, kDbcIdentRegExp);
-    const QRegularExpression sigValTypeRegEx(regExStr);
-
-    const auto match = sigValTypeRegEx.matchView(data);
-    if (!match.hasMatch()) {
+    View messageId;
+    View sigNameView;
+    View typeView;
+    const qsizetype end = findDefinition(data, kSigValTypeDef, [&](DbcLineReader<View> &in) {
+        in.skipSpaces();
+        if (!in.unsignedInt(&messageId) || !in.spaces() || !in.identifier(&sigNameView))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u':'))
+            return false;
+        in.skipSpaces();
+        if (!in.unsignedInt(&typeView))
+            return false;
+        in.skipSpaces();
+        return in.character(u';');
+    });
+    if (end == -1) {
         m_lineOffset = data.size();
         addWarning(QObject::tr("Failed to find signal value type description in string %1").
-                   arg(data));
+                   arg(toString(data)));
         return;
     }
 
-    m_lineOffset = match.capturedEnd(0);
+    m_lineOffset = end;
 
-    const auto uidOptional = extractUniqueId(match.capturedView(u"messageId"_s));
+    const auto uidOptional = extractUniqueId(messageId);
     if (!uidOptional) {
-        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(data));
+        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(toString(data)));
         return;
     }
 
     const QtCanBus::UniqueId uid = uidOptional.value();
     auto msgDesc = m_messageDescriptions.value(uid);
     if (msgDesc.isValid()) {
-        const QString sigName = match.captured(u"sigName"_s);
+        const QString sigName = toString(sigNameView);
         auto sigDesc = msgDesc.signalDescriptionForName(sigName);
         if (sigDesc.isValid()) {
             bool ok = false;
-            const auto type = match.capturedView(u"type").toUInt(&ok);
+            const auto type = typeView.toUInt(&ok);
             if (ok) {
                 bool sigDescChanged = false;
                 switch (type) {
@@ -800,84 +1545,93 @@ void QCanDbcFileParserPrivate::parseSignalType(const QStringView data)
                     m_messageDescriptions.insert(msgDesc.uniqueId(), msgDesc);
                 }
             } else {
-                addWarning(QObject::tr("Failed to parse data type from string %1").arg(data));
+                addWarning(QObject::tr("Failed to parse data type from string %1").
+                           arg(toString(data)));
             }
         } else {
             addWarning(QObject::tr("Failed to find signal description for signal %1. "
-                                   "Skipping string %2").arg(sigName, data));
+                                   "Skipping string %2").arg(sigName, toString(data)));
         }
     } else {
+        m_hasUnresolvedReferences = true;
         addWarning(QObject::tr("Failed to find message description for unique id %1. "
-                               "Skipping string %2").arg(qToUnderlying(uid)).arg(data));
+                               "Skipping string %2").arg(qToUnderlying(uid)).arg(toString(data)));
     }
 }
 
-void QCanDbcFileParserPrivate::parseComment(const QStringView data)
+template <typename View>
+void QCanDbcFileParserPrivate::parseComment(const View data)
 {
     // The comment for message or signal description is represented by the
     // following pattern:
     //      CM_ (BO_ message_id char_string | SG_ message_id signal_name char_string);
-
-    // %1 commentDef
-    // %2 maybeSpace
-    // %3 messageDef
-    // %4 signalDef
-    // %5 oneOrMoreSpace
-    // %6 unsignedInt
-    // %7 DbcIdentifier
-    // %8 charStr
-    const QString regExStr =
-            "%1%2(?<type>(%3|%4))%2(?<messageId>%6)%5((?<sigName>%7)%5)?\"(?<comment>%8)\"%2;"_L1.
-            arg(kCommentDef, kMaybeSpaceRegExp, kMessageDef, kSignalDef, kOneOrMoreSpaceRegExp,
-                kUnsignedIntRegExp, kDbcIdentRegExp, kCharStrRegExp);
-    const QRegularExpression commentRegExp(regExStr);
-
-    const auto match = commentRegExp.matchView(data);
-    if (!match.hasMatch()) {
+    View type;
+    View messageId;
+    View sigNameView;
+    View commentView;
+    const qsizetype end = findDefinition(data, kCommentDef, [&](DbcLineReader<View> &in) {
+        sigNameView = {};
+        in.skipSpaces();
+        if (!in.keyword(kMessageDef, &type) && !in.keyword(kSignalDef, &type))
+            return false;
+        in.skipSpaces();
+        if (!in.unsignedInt(&messageId) || !in.spaces())
+            return false;
+        const qsizetype nameStart = in.position();
+        if (!in.identifier(&sigNameView) || !in.spaces()) {
+            in.setPosition(nameStart);
+            sigNameView = {};
+        }
+        if (!in.charString(&commentView))
+            return false;
+        in.skipSpaces();
+        return in.character(u';');
+    });
+    if (end == -1) {
         // no warning here, as we ignore some "general" comments, and parse only
         // comments related to messages and signals
         m_lineOffset = data.size();
         return;
     }
 
-    m_lineOffset = match.capturedEnd(0);
-
-    const auto type = match.capturedView(u"type"_s);
+    m_lineOffset = end;
 
-    const auto uidOptional = extractUniqueId(match.capturedView(u"messageId"_s));
+    const auto uidOptional = extractUniqueId(messageId);
     if (!uidOptional) {
-        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(data));
+        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(toString(data)));
         return;
     }
 
     const QtCanBus::UniqueId uid = uidOptional.value();
     auto messageDesc = m_messageDescriptions.value(uid);
     if (!messageDesc.isValid()) {
+        m_hasUnresolvedReferences = true;
         addWarning(QObject::tr("Failed to find message description for unique id %1. "
-                               "Skipping string %2").arg(qToUnderlying(uid)).arg(data));
+                               "Skipping string %2").arg(qToUnderlying(uid)).arg(toString(data)));
         return;
     }
 
-    if (type == kMessageDef) {
-        const QString comment = match.captured(u"comment"_s);
+    if (equals(type, kMessageDef)) {
+        const QString comment = toString(commentView);
         messageDesc.setComment(comment);
         m_messageDescriptions.insert(uid, messageDesc);
-    } else if (type == kSignalDef) {
-        const QString sigName = match.captured(u"sigName"_s);
+    } else if (equals(type, kSignalDef)) {
+        const QString sigName = toString(sigNameView);
         auto signalDesc = messageDesc.signalDescriptionForName(sigName);
         if (signalDesc.isValid()) {
-            const QString comment = match.captured(u"comment"_s);
+            const QString comment = toString(commentView);
             signalDesc.setComment(comment);
             messageDesc.addSignalDescription(signalDesc);
             m_messageDescriptions.insert(uid, messageDesc);
         } else {
             addWarning(QObject::tr("Failed to find signal description for signal %1. "
-                                   "Skipping string %2").arg(sigName, data));
+                                   "Skipping string %2").arg(sigName, toString(data)));
         }
     }
 }
 
-void QCanDbcFileParserPrivate::parseExtendedMux(const QStringView data)
+template <typename View>
+void QCanDbcFileParserPrivate::parseExtendedMux(const View data)
 {
     // The extended multiplexing is defined by the following pattern:
     //      SG_MUL_VAL_ message_id multiplexed_signal_name
@@ -886,44 +1640,75 @@ void QCanDbcFileParserPrivate::parseExtendedMux(const QStringView data)
     // by a whitespace, and one range is defined as follows:
     //      multiplexor_value_range = unsigned_integer - unsigned_integer
 
-    // %1 extendedMuxDef
-    // %2 maybeSpace
-    // %3 unsignedInt
-    // %4 oneOrMoreSpace
-    // %5 DbcIdentifier
-    const QString regExStr =
-            "%1%2(?<messageId>%3)%4(?<multiplexedSignal>%5)%4(?<multiplexorSwitch>%5)%4"
-            "(?<firstRange>%3%2-%2%3)(%2,%2%3%2-%2%3)*%2;"_L1.
-            arg(kExtendedMuxDef, kMaybeSpaceRegExp, kUnsignedIntRegExp, kOneOrMoreSpaceRegExp,
-                kDbcIdentRegExp);
-    const QRegularExpression extendedMuxRegExp(regExStr);
-
-    const auto match = extendedMuxRegExp.matchView(data);
-    if (!match.hasMatch()) {
+    View messageId;
+    View multiplexedSignalView;
+    View multiplexorSwitchView;
+    QVarLengthArray<std::pair<View, View>, 4> ranges;
+    auto readRange = [&ranges](DbcLineReader<View> &in) {
+        View min;
+        View max;
+        if (!in.unsignedInt(&min))
+            return false;
+        in.skipSpaces();
+        if (!in.character(u'-'))
+            return false;
+        in.skipSpaces();
+        if (!in.unsignedInt(&max))
+            return false;
+        ranges.push_back({min, max});
+        return true;
+    };
+    const qsizetype end = findDefinition(data, kExtendedMuxDef, [&](DbcLineReader<View> &in) {
+        ranges.clear();
+        in.skipSpaces();
+        if (!in.unsignedInt(&messageId) || !in.spaces()
+                || !in.identifier(&multiplexedSignalView) || !in.spaces()
+                || !in.identifier(&multiplexorSwitchView) || !in.spaces()
+                || !readRange(in)) {
+            return false;
+        }
+        while (true) {
+            const qsizetype rangeEnd = in.position();
+            in.skipSpaces();
+            if (!in.character(u',')) {
+                in.setPosition(rangeEnd);
+                break;
+            }
+            in.skipSpaces();
+            if (!readRange(in)) {
+                in.setPosition(rangeEnd);
+                break;
+            }
+        }
+        in.skipSpaces();
+        return in.character(u';');
+    });
+    if (end == -1) {
         m_lineOffset = data.size();
         addWarning(QObject::tr("Failed to find extended multiplexing description in string %1").
-                   arg(data));
+                   arg(toString(data)));
         return;
     }
 
-    m_lineOffset = match.capturedEnd(0);
+    m_lineOffset = end;
 
-    const auto uidOptional = extractUniqueId(match.capturedView(u"messageId"_s));
+    const auto uidOptional = extractUniqueId(messageId);
     if (!uidOptional) {
-        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(data));
+        addWarning(QObject::tr("Failed to parse frame id from string %1").arg(toString(data)));
         return;
     }
 
     const QtCanBus::UniqueId uid = uidOptional.value();
     auto messageDesc = m_messageDescriptions.value(uid);
     if (!messageDesc.isValid()) {
+        m_hasUnresolvedReferences = true;
         addWarning(QObject::tr("Failed to find message description for unique id %1. "
-                               "Skipping string %2").arg(qToUnderlying(uid)).arg(data));
+                               "Skipping string %2").arg(qToUnderlying(uid)).arg(toString(data)));
         return;
     }
 
-    const QString multiplexedSignalName = match.captured(u"multiplexedSignal"_s);
-    const QString multiplexorSwitchName = match.captured(u"multiplexorSwitch"_s);
+    const QString multiplexedSignalName = toString(multiplexedSignalView);
+    const QString multiplexorSwitchName = toString(multiplexorSwitchView);
 
     auto multiplexedSignal = messageDesc.signalDescriptionForName(multiplexedSignalName);
     auto multiplexorSwitch = messageDesc.signalDescriptionForName(multiplexorSwitchName);
@@ -932,7 +1717,7 @@ void QCanDbcFileParserPrivate::parseExtendedMux(const QStringView data)
         const QString invalidName = multiplexedSignal.isValid() ? multiplexorSwitchName
                                                                 : multiplexedSignalName;
         addWarning(QObject::tr("Failed to find signal description for signal %1. "
-                               "Skipping string %2").arg(invalidName, data));
+                               "Skipping string %2").arg(invalidName, toString(data)));
         return;
     }
 
@@ -940,33 +1725,9 @@ void QCanDbcFileParserPrivate::parseExtendedMux(const QStringView data)
     signalRanges.remove(kQtDummySignal); // dummy signal not needed anymore
 
     QCanSignalDescription::MultiplexValues rangeValues;
-    auto rangeView = match.capturedView(u"firstRange"_s);
-    const auto sepIdx = rangeView.indexOf(u'-');
-    if (sepIdx != -1) {
-        const auto min = rangeView.first(sepIdx).trimmed().toUInt();
-        const auto max = rangeView.sliced(sepIdx + 1).trimmed().toUInt();
-        rangeValues.push_back({min, max});
-    }
-
-    // We can have an arbitrary amount of ranges, so we can't use capture groups
-    // to capture them. But we know that they follow a specific pattern (because
-    // the full string matched the regexp). So we need to parse the rest of the
-    // matched string manually
-    const auto totalEnd = match.capturedEnd(0); // including the ';'
-    const auto firstRangeEnd = match.capturedEnd(u"firstRange"_s);
-    const auto len = totalEnd - firstRangeEnd - 1;
-    if (len > 0) {
-        const auto otherRangesView = data.sliced(firstRangeEnd, len).trimmed();
-        const QStringTokenizer parts = otherRangesView.tokenize(u',', Qt::SkipEmptyParts);
-        for (const QStringView range : parts) {
-            const auto sepIdx = range.indexOf(u'-');
-            if (sepIdx != -1) {
-                const auto min = range.first(sepIdx).trimmed().toUInt();
-                const auto max = range.sliced(sepIdx + 1).trimmed().toUInt();
-                rangeValues.push_back({min, max});
-            }
-        }
-    }
+    rangeValues.reserve(ranges.size());
+    for (const auto &[min, max] : std::as_const(ranges))
+        rangeValues.push_back({min.toUInt(), max.toUInt()});
 
     if (!rangeValues.isEmpty())
         signalRanges.insert(multiplexorSwitchName, rangeValues);
@@ -979,38 +1740,53 @@ void QCanDbcFileParserPrivate::parseExtendedMux(const QStringView data)
     m_messageDescriptions.insert(uid, messageDesc);
 }
 
-void QCanDbcFileParserPrivate::parseValueDescriptions(const QStringView data)
+template <typename View>
+void QCanDbcFileParserPrivate::parseValueDescriptions(const View data)
 {
-    // The regexp should match the following pattern:
+    // The value descriptions have the following definition:
     //      VAL_ message_id signal_name { value_description };
     // Here the value_description is defined as follows
     //      value_description = unsigned_int char_string
-
-    // %1 valDef
-    // %2 maybeSpace
-    // %3 unsignedInt
-    // %4 oneOrMoreSpace
-    // %5 DbcIdentifier
-    // %6 charStr
-    const QString regExStr =
-            "%1%2(?<messageId>%3)%4(?<signalName>%5)(%4%3%4\"(%6)\")+%2;"_L1.
-            arg(kValDef, kMaybeSpaceRegExp, kUnsignedIntRegExp, kOneOrMoreSpaceRegExp,
-                kDbcIdentRegExp, kCharStrRegExp);
-
-    const QRegularExpression valueDescRegExp(regExStr);
-
-    const auto match = valueDescRegExp.matchView(data);
-    if (!match.hasMatch()) {
+    View messageId;
+    View signalNameView;
+    QVarLengthArray<std::pair<View, View>, 16> descriptions;
+    auto readDescription = [&descriptions](DbcLineReader<View> &in) {
+        View value;
+        View description;
+        const qsizetype start = in.position();
+        if (in.spaces() && in.unsignedInt(&value) && in.spaces()
+                && in.charString(&description)) {
+            descriptions.push_back({value, description});
+            return true;
+        }
+        in.setPosition(start);
+        return false;
+    };
+    const qsizetype end = findDefinition(data, kValDef, [&](DbcLineReader<View> &in) {
+        descriptions.clear();
+        in.skipSpaces();
+        if (!in.unsignedInt(&messageId) || !in.spaces() || !in.identifier(&signalNameView)
+                || !readDescription(in)) {
+            return false;
+        }
+        while (readDescription(in)) {
+        }
+        in.skipSpaces();
+        return in.character(u';');
+    });
+    if (end == -1) {
         m_lineOffset = data.size();
-        addWarning(QObject::tr("Failed to parse value description from string %1").arg(data));
+        addWarning(QObject::tr("Failed to parse value description from string %1").
+                   arg(toString(data)));
         return;
     }
 
-    m_lineOffset = match.capturedEnd(0);
+    m_lineOffset = end;
 
-    const auto uidOptional = extractUniqueId(match.capturedView(u"messageId"_s));
+    const auto uidOptional = extractUniqueId(messageId);
     if (!uidOptional) {
-        addWarning(QObject::tr("Failed to parse value description from string %1").arg(data));
+        addWarning(QObject::tr("Failed to parse value description from string %1").
+                   arg(toString(data)));
         return;
     }
 
@@ -1018,48 +1794,26 @@ void QCanDbcFileParserPrivate::parseValueDescriptions(const QStringView data)
     // Check if the message exists
     const auto messageDesc = m_messageDescriptions.value(uid);
     if (!messageDesc.isValid()) {
+        m_hasUnresolvedReferences = true;
         addWarning(QObject::tr("Failed to find message description for unique id %1. "
-                               "Skipping string %2").arg(qToUnderlying(uid)).arg(data));
+                               "Skipping string %2").arg(qToUnderlying(uid)).arg(toString(data)));
         return;
     }
 
     // Check if the signal exists within the message
-    const QString signalName = match.captured(u"signalName"_s);
+    const QString signalName = intern(signalNameView);
     if (!messageDesc.signalDescriptionForName(signalName).isValid()) {
         addWarning(QObject::tr("Failed to find signal description for signal %1. "
-                               "Skipping string %2").arg(signalName, data));
+                               "Skipping string %2").arg(signalName, toString(data)));
         return;
     }
 
-    // We can have an arbitrary amount of value descriptions, so we can't use
-    // capture groups to capture them. But we know that they follow a specific
-    // pattern (because the full string matched the regexp). So we need to parse
-    // the rest of the matched string manually
-    const auto totalEnd = match.capturedEnd(0); // including the ';'
-    const auto signalNameEnd = match.capturedEnd(u"signalName"_s);
-    const auto len = totalEnd - signalNameEnd - 1;
-    if (len > 0) {
-        auto signalDescriptionsView = data.sliced(signalNameEnd, len).trimmed();
-        while (signalDescriptionsView.size()) {
-            const auto spacePos = signalDescriptionsView.indexOf(u' ');
-            if (spacePos == -1)
-                break;
-            bool ok = false;
-            const auto value = signalDescriptionsView.sliced(0, spacePos).toUInt(&ok);
-            if (!ok)
-                break;
-            const auto firstQuotePos = signalDescriptionsView.indexOf(u'"', spacePos + 1);
-            if (firstQuotePos == -1)
-                break;
-            const auto nextQuotePos = signalDescriptionsView.indexOf(u'"', firstQuotePos + 1);
-            if (nextQuotePos == -1)
-                break;
-            const auto description = signalDescriptionsView.sliced(
-                        firstQuotePos + 1, nextQuotePos - firstQuotePos - 1);
-
-            m_valueDescriptions[uid][signalName].insert(value, description.toString());
-            signalDescriptionsView = signalDescriptionsView.sliced(nextQuotePos + 1).trimmed();
-        }
+    for (const auto &[valueView, description] : std::as_const(descriptions)) {
+        bool ok = false;
+        const auto value = valueView.toUInt(&ok);
+        if (!ok)
+            break;
+        m_valueDescriptions[uid][signalName].insert(value, intern(description));
     }
 }
 
@@ -1099,9 +1853,14 @@ void QCanDbcFileParserPrivate::postProcessSignalMultiplexing()
             // iterate through all signal descriptions and update kQtDummySignal
             for (auto &signalDesc : signalDescriptions) {
                 if (signalDesc.multiplexState() == QtCanBus::MultiplexState::MultiplexedSignal) {
+                    // The messages of the previously parsed files are already
+                    // processed, so keep their values
                     auto &muxValues = QCanSignalDescriptionPrivate::get(signalDesc)->muxSignals;
-                    auto val = muxValues.value(kQtDummySignal);
-                    muxValues.remove(kQtDummySignal);
+                    const auto it = muxValues.constFind(kQtDummySignal);
+                    if (it == muxValues.cend())
+                        continue;
+                    const auto val = it.value();
+                    muxValues.erase(it);
                     muxValues.insert(multiplexorSignal, val);
                 }
             }
@@ -1128,6 +1887,206 @@ void QCanDbcFileParserPrivate::postProcessSignalMultiplexing()
     }
 }
 
+/* Precompiled cache */
+
+// The cache starts with the magic number ("QDBC") and the format version,
+// followed by the hash of the content of the parsed files, and the parsed
+// data. Increase the version when changing the format.
+static constexpr quint32 kCacheMagic = 0x51444243;
+static constexpr quint16 kCacheVersion = 1;
+static constexpr auto kCacheStreamVersion = QDataStream::Qt_6_5;
+
+static std::optional<QByteArray> contentHash(const QStringList &fileNames)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const auto &fileName : fileNames) {
+        QFile f(fileName);
+        if (!f.open(QIODevice::ReadOnly))
+            return std::nullopt;
+        // separate the contents of the files
+        const quint64 size = qToLittleEndian(quint64(f.size()));
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&size), sizeof(size)));
+        if (!hash.addData(&f))
+            return std::nullopt;
+    }
+    return hash.result();
+}
+
+static void writeSignal(QDataStream &out, const QCanSignalDescription &desc)
+{
+    const auto *d = QCanSignalDescriptionPrivate::get(desc);
+    out << d->name << d->unit << d->receiver << d->comment
+        << quint8(d->source) << quint8(d->endian) << quint8(d->format)
+        << d->startBit << d->dataLength
+        << d->factor << d->offset << d->scaling << d->minimum << d->maximum
+        << quint8(d->muxState) << quint32(d->muxSignals.size());
+    for (const auto &[name, ranges] : d->muxSignals.asKeyValueRange()) {
+        out << name << quint32(ranges.size());
+        for (const auto &range : ranges)
+            out << range.minimum << range.maximum;
+    }
+}
+
+static QCanSignalDescription readSignal(QDataStream &in, QSet<QString> &stringPool)
+{
+    QCanSignalDescription desc;
+    auto *d = QCanSignalDescriptionPrivate::get(desc);
+    quint8 source = 0;
+    quint8 endian = 0;
+    quint8 format = 0;
+    quint8 muxState = 0;
+    quint32 muxSignalCount = 0;
+    in >> d->name >> d->unit >> d->receiver >> d->comment
+       >> source >> endian >> format
+       >> d->startBit >> d->dataLength
+       >> d->factor >> d->offset >> d->scaling >> d->minimum >> d->maximum
+       >> muxState >> muxSignalCount;
+    d->name = internString(stringPool, std::move(d->name));
+    d->unit = internString(stringPool, std::move(d->unit));
+    d->receiver = internString(stringPool, std::move(d->receiver));
+    d->source = QtCanBus::DataSource(source);
+    d->endian = QSysInfo::Endian(endian);
+    d->format = QtCanBus::DataFormat(format);
+    d->muxState = QtCanBus::MultiplexState(muxState);
+    for (quint32 i = 0; i < muxSignalCount && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        quint32 rangeCount = 0;
+        in >> name >> rangeCount;
+        QCanSignalDescription::MultiplexValues ranges;
+        for (quint32 j = 0; j < rangeCount && in.status() == QDataStream::Ok; ++j) {
+            QCanSignalDescription::MultiplexValueRange range;
+            in >> range.minimum >> range.maximum;
+            ranges.push_back(std::move(range));
+        }
+        d->muxSignals.insert(name, ranges);
+    }
+    return desc;
+}
+
+static void writeMessage(QDataStream &out, const QCanMessageDescription &desc)
+{
+    const auto *d = QCanMessageDescriptionPrivate::get(desc);
+    out << qToUnderlying(d->id) << d->name << d->size << d->transmitter << d->comment
+        << quint32(d->messageSignals.size());
+    for (const auto &signalDesc : d->messageSignals)
+        writeSignal(out, signalDesc);
+}
+
+static QCanMessageDescription readMessage(QDataStream &in, QSet<QString> &stringPool)
+{
+    QCanMessageDescription desc;
+    auto *d = QCanMessageDescriptionPrivate::get(desc);
+    quint32 id = 0;
+    quint32 signalCount = 0;
+    in >> id >> d->name >> d->size >> d->transmitter >> d->comment >> signalCount;
+    d->id = QtCanBus::UniqueId{id};
+    d->transmitter = internString(stringPool, std::move(d->transmitter));
+    for (quint32 i = 0; i < signalCount && in.status() == QDataStream::Ok; ++i) {
+        const QCanSignalDescription signalDesc = readSignal(in, stringPool);
+        d->messageSignals.insert(signalDesc.name(), signalDesc);
+    }
+    return desc;
+}
+
+bool QCanDbcFileParserPrivate::saveCache(const QString &cacheFileName) const
+{
+    if (m_error != QCanDbcFileParser::Error::None || m_parsedFileNames.isEmpty())
+        return false;
+
+    const auto hash = contentHash(m_parsedFileNames);
+    if (!hash)
+        return false;
+
+    QSaveFile f(cacheFileName);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&f);
+    out.setVersion(kCacheStreamVersion);
+    out << kCacheMagic << kCacheVersion << hash.value();
+
+    out << quint32(m_messageDescriptions.size());
+    for (const auto &messageDesc : m_messageDescriptions)
+        writeMessage(out, messageDesc);
+
+    out << quint32(m_valueDescriptions.size());
+    for (const auto &[uid, signalValues] : m_valueDescriptions.asKeyValueRange()) {
+        out << qToUnderlying(uid) << quint32(signalValues.size());
+        for (const auto &[signalName, values] : signalValues.asKeyValueRange())
+            out << signalName << values;
+    }
+
+    out << m_warnings;
+
+    return out.status() == QDataStream::Ok && f.commit();
+}
+
+bool QCanDbcFileParserPrivate::loadCache(const QString &cacheFileName,
+                                         const QStringList &fileNames)
+{
+    auto setCacheError = [this](QString &&description) {
+        reset();
+        m_error = QCanDbcFileParser::Error::InvalidCache;
+        m_errorString = std::move(description);
+        return false;
+    };
+
+    QFile f(cacheFileName);
+    if (!f.open(QIODevice::ReadOnly))
+        return setCacheError(f.errorString());
+
+    QDataStream in(&f);
+    in.setVersion(kCacheStreamVersion);
+    quint32 magic = 0;
+    quint16 version = 0;
+    QByteArray hash;
+    in >> magic >> version;
+    if (magic != kCacheMagic || version != kCacheVersion)
+        return setCacheError(QObject::tr("Unsupported format of cache file %1.").
+                             arg(cacheFileName));
+
+    in >> hash;
+    if (hash != contentHash(fileNames))
+        return setCacheError(QObject::tr("Cache file %1 is outdated.").arg(cacheFileName));
+
+    if (!readCacheData(in))
+        return setCacheError(QObject::tr("Cache file %1 is corrupted.").arg(cacheFileName));
+
+    m_parsedFileNames = fileNames;
+    return true;
+}
+
+bool QCanDbcFileParserPrivate::readCacheData(QDataStream &in)
+{
+    quint32 messageCount = 0;
+    in >> messageCount;
+    for (quint32 i = 0; i < messageCount && in.status() == QDataStream::Ok; ++i) {
+        const QCanMessageDescription messageDesc = readMessage(in, m_stringPool);
+        m_messageDescriptions.insert(messageDesc.uniqueId(), messageDesc);
+    }
+
+    quint32 uidCount = 0;
+    in >> uidCount;
+    for (quint32 i = 0; i < uidCount && in.status() == QDataStream::Ok; ++i) {
+        quint32 uid = 0;
+        quint32 signalCount = 0;
+        in >> uid >> signalCount;
+        auto &signalValues = m_valueDescriptions[QtCanBus::UniqueId{uid}];
+        for (quint32 j = 0; j < signalCount && in.status() == QDataStream::Ok; ++j) {
+            QString signalName;
+            QCanDbcFileParser::ValueDescriptions values;
+            in >> signalName >> values;
+            for (QString &description : values)
+                description = internString(m_stringPool, std::move(description));
+            signalValues.insert(internString(m_stringPool, std::move(signalName)), values);
+        }
+    }
+
+    in >> m_warnings;
+
+    return in.status() == QDataStream::Ok && in.atEnd();
+}
+
 void QCanDbcFileParserPrivate::addWarning(QString &&warning)
 {
     m_warnings.emplace_back(warning);
@@ -1140,12 +2099,15 @@ void QCanDbcFileParserPrivate::addCurrentMessage()
         if (!m_currentMessage.isValid()) {
             addWarning(QObject::tr("Message description with unique id %1 is skipped "
                                    "because it's not valid.").arg(qToUnderlying(uid)));
-        } else if (m_messageDescriptions.contains(uid)) {
-            addWarning(QObject::tr("Message description with unique id %1 is skipped "
-                                   "because such unique id is already used.").
-                       arg(qToUnderlying(uid)));
         } else {
-            m_messageDescriptions.insert(uid, m_currentMessage);
+            if (m_messageDescriptions.contains(uid)) {
+                addWarning(QObject::tr("Message description with unique id %1 is skipped "
+                                       "because such unique id is already used.").
+                           arg(qToUnderlying(uid)));
+            } else {
+                m_messageDescriptions.insert(uid, m_currentMessage);
+            }
+            m_definedUniqueIds.push_back(uid);
         }
         m_currentMessage = {};
         m_isProcessingMessage = false;
@@ -4,11 +4,14 @@
 #ifndef QCANDBCFILEPARSER_H
 #define QCANDBCFILEPARSER_H
 
+#include <QtCore/QByteArrayView>
 #include <QtCore/QList>
+#include <QtCore/QString>
 
 #include <QtSerialBus/qcancommondefinitions.h>
 #include <QtSerialBus/qtserialbusglobal.h>
 
+#include <chrono>
 #include <memory>
 
 QT_BEGIN_NAMESPACE
@@ -23,7 +26,8 @@ public:
     enum class Error : quint8 {
         None = 0,
         FileReading,
-        Parsing
+        Parsing,
+        InvalidCache
     };
 
     // The DBC protocol uses unsigned_integer to describe the supported values.
@@ -33,6 +37,14 @@ public:
     using SignalValueDescriptions = QHash<QString, ValueDescriptions>;
     using MessageValueDescriptions = QHash<QtCanBus::UniqueId, SignalValueDescriptions>;
 
+    struct FileStatistics
+    {
+        QString fileName;
+        std::chrono::nanoseconds parseTime{0};
+        qsizetype messageCount = 0;
+        qsizetype warningCount = 0;
+    };
+
     Q_SERIALBUS_EXPORT QCanDbcFileParser();
     Q_SERIALBUS_EXPORT ~QCanDbcFileParser();
 
@@ -40,12 +52,19 @@ public:
     Q_SERIALBUS_EXPORT bool parse(const QStringList &fileNames);
     Q_SERIALBUS_EXPORT bool parseData(QStringView data);
 
+    Q_SERIALBUS_EXPORT bool feed(QByteArrayView data);
+    Q_SERIALBUS_EXPORT bool finishFeed();
+
+    Q_SERIALBUS_EXPORT bool saveCache(const QString &cacheFileName) const;
+    Q_SERIALBUS_EXPORT bool loadCache(const QString &cacheFileName, const QStringList &fileNames);
+
     Q_SERIALBUS_EXPORT QList<QCanMessageDescription> messageDescriptions() const;
     Q_SERIALBUS_EXPORT MessageValueDescriptions messageValueDescriptions() const;
 
     Q_SERIALBUS_EXPORT Error error() const;
     Q_SERIALBUS_EXPORT QString errorString() const;
     Q_SERIALBUS_EXPORT QStringList warnings() const;
+    Q_SERIALBUS_EXPORT QList<FileStatistics> fileStatistics() const;
 
     Q_SERIALBUS_EXPORT static QCanUniqueIdDescription uniqueIdDescription();
 
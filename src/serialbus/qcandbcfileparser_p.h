@@ -19,34 +19,85 @@
 #include "qcanmessagedescription.h"
 
 #include <QtCore/QHash>
+#include <QtCore/QSet>
 
 QT_BEGIN_NAMESPACE
 
 class QCanSignalDescription;
+class QDataStream;
 
 class QCanDbcFileParserPrivate
 {
 public:
+    // BO_ message_id message_name ':' message_size transmitter
+    template <typename View>
+    struct MessageTokens
+    {
+        View messageId;
+        View name;
+        View size;
+        View transmitter;
+    };
+
+    // SG_ signal_name multiplexer_indicator ':' start_bit '|' signal_size '@'
+    // byte_order value_type '(' factor ',' offset ')' '[' minimum '|' maximum ']'
+    // unit receiver {',' receiver}
+    template <typename View>
+    struct SignalTokens
+    {
+        View name;
+        View mux;
+        View startBit;
+        View sigSize;
+        View byteOrder;
+        View valueType;
+        View factor;
+        View offset;
+        View min;
+        View max;
+        View unit;
+        View receiver;
+    };
+
+    // The parsing functions are instantiated for QByteArrayView (UTF-8 encoded
+    // file content) and QStringView (the data passed to parseData()).
     void reset();
+    bool parseFiles(const QStringList &fileNames);
     bool parseFile(const QString &fileName);
+    bool canMerge(const QCanDbcFileParserPrivate &other) const;
+    void merge(QCanDbcFileParserPrivate &&other);
+    bool saveCache(const QString &cacheFileName) const;
+    bool loadCache(const QString &cacheFileName, const QStringList &fileNames);
+    bool readCacheData(QDataStream &in);
     bool parseData(QStringView data);
-    bool processLine(const QStringView line);
-    bool parseMessage(const QStringView data);
-    QCanMessageDescription extractMessage(const QRegularExpressionMatch &match);
-    bool parseSignal(const QStringView data);
-    QCanSignalDescription extractSignal(const QRegularExpressionMatch &match);
-    void parseSignalType(const QStringView data);
-    void parseComment(const QStringView data);
-    void parseExtendedMux(const QStringView data);
-    void parseValueDescriptions(const QStringView data);
+    template <typename View> bool parseLines(View data);
+    template <typename View> bool processLines(View data);
+    bool feed(QByteArrayView data);
+    bool finishFeed();
+    template <typename View> bool processLine(const View line);
+    template <typename View> bool parseMessage(const View data);
+    template <typename View>
+    QCanMessageDescription extractMessage(const MessageTokens<View> &tokens);
+    template <typename View> bool parseSignal(const View data);
+    template <typename View>
+    QCanSignalDescription extractSignal(const SignalTokens<View> &tokens);
+    template <typename View> void parseSignalType(const View data);
+    template <typename View> void parseComment(const View data);
+    template <typename View> void parseExtendedMux(const View data);
+    template <typename View> void parseValueDescriptions(const View data);
     void postProcessSignalMultiplexing();
 
+    template <typename View> QString intern(View str);
     void addWarning(QString &&warning);
     void addCurrentMessage();
 
     QList<QCanMessageDescription> getMessages() const;
 
     QString m_fileName;
+    QStringList m_parsedFileNames;
+    QByteArray m_pendingData; // incomplete line received by feed()
+    bool m_isFeeding = false;
+    bool m_feedStarted = false; // feed() has checked the data for a UTF-8 BOM
     QCanDbcFileParser::Error m_error = QCanDbcFileParser::Error::None;
     QString m_errorString;
     QStringList m_warnings;
@@ -56,6 +107,12 @@ public:
     QCanMessageDescription m_currentMessage;
     QHash<QtCanBus::UniqueId, QCanMessageDescription> m_messageDescriptions;
     QCanDbcFileParser::MessageValueDescriptions m_valueDescriptions;
+    QList<QCanDbcFileParser::FileStatistics> m_fileStatistics;
+    // Used to check if the files that were parsed separately can be merged
+    QList<QtCanBus::UniqueId> m_definedUniqueIds;
+    bool m_hasUnresolvedReferences = false;
+    // Shared copies of the repeated strings, see intern()
+    QSet<QString> m_stringPool;
 };
 
 QT_END_NAMESPACE
@@ -13,6 +13,16 @@
 #include <QtCore/QMap>
 #include <QtCore/QVariant>
 #include <QtCore/QtEndian>
+#include <QtCore/private/qsimd_p.h>
+#if QT_CONFIG(thread)
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -87,9 +97,23 @@ static quint16 extractMaxBitNum(quint16 startBit, quint16 bitLength, QSysInfo::E
     \l {QCanSignalDescription::name}{signal names}, and the values of the map
     are signal values.
 
+    For high frame rates, the \l {parseFrame(const QCanBusFrame &, QSpan<double>)}
+    {parseFrame()} overloads taking a span of numbers can be used instead.
+    They write the signal values into a caller-provided array, at the
+    positions given by \l signalIndex(), and do not allocate any memory.
+
+    The \l decodeFrame() and \l decodeFrames() methods do not modify the
+    processor. They return the error and the warnings together with the
+    decoded values of each frame, so they can be called from multiple
+    threads at the same time. \l decodeFrames() also decodes large batches
+    of frames, like recorded traces, using all available cores.
+
     The \l prepareFrame() method can be used to generate a \l QCanBusFrame
     object for a specific unique identifier, using the provided signal names
-    and desired values.
+    and desired values. The \l {prepareFrame(QtCanBus::UniqueId,
+    QSpan<const double>, QCanBusFrame *)}{prepareFrame()} overloads taking a
+    span of numbers read the values from the positions given by
+    \l signalIndex() instead, and reuse the payload of an existing frame.
 
     Errors can occur during the encoding or decoding process. In such cases
     the \l error() and \l errorString() methods can be used to get the
@@ -144,6 +168,44 @@ static quint16 extractMaxBitNum(quint16 startBit, quint16 bitLength, QSysInfo::E
     and the values of the map are signal values.
 */
 
+/*!
+    \struct QCanFrameProcessor::FrameResult
+    \inmodule QtSerialBus
+    \since 6.9
+
+    \brief The struct is used as a return value for the
+    \l QCanFrameProcessor::decodeFrame() and
+    \l QCanFrameProcessor::decodeFrames() methods.
+*/
+
+/*!
+    \variable QCanFrameProcessor::FrameResult::uniqueId
+    \brief the value of the unique identifier of the decoded frame.
+*/
+
+/*!
+    \variable QCanFrameProcessor::FrameResult::signalValues
+    \brief the map containing the extracted signals and their values.
+    The keys of the map are the \l {QCanSignalDescription::name}{signal names},
+    and the values of the map are signal values.
+*/
+
+/*!
+    \variable QCanFrameProcessor::FrameResult::error
+    \brief the error that occurred while decoding the frame, or
+    \l {QCanFrameProcessor::Error}{Error::None}.
+*/
+
+/*!
+    \variable QCanFrameProcessor::FrameResult::errorString
+    \brief the text description of the \l error.
+*/
+
+/*!
+    \variable QCanFrameProcessor::FrameResult::warnings
+    \brief the warnings generated while decoding the frame.
+*/
+
 /*!
     Creates a CAN frame processor.
 */
@@ -192,18 +254,18 @@ QCanFrameProcessor::~QCanFrameProcessor() = default;
 QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
                                               const QVariantMap &signalValues)
 {
-    d->resetErrors();
+    d->state.resetErrors();
 
     if (!d->uidDescription.isValid()) {
-        d->setError(Error::Encoding,
-                    QObject::tr("No valid unique identifier description is specified."));
+        d->state.setError(Error::Encoding,
+                          QObject::tr("No valid unique identifier description is specified."));
         return QCanBusFrame(QCanBusFrame::InvalidFrame);
     }
 
     if (!d->messages.contains(uniqueId)) {
-        d->setError(Error::Encoding,
-                    QObject::tr("Failed to find message description for unique id %1.").
-                    arg(qToUnderlying(uniqueId)));
+        d->state.setError(Error::Encoding,
+                          QObject::tr("Failed to find message description for unique id %1.").
+                          arg(qToUnderlying(uniqueId)));
         return QCanBusFrame(QCanBusFrame::InvalidFrame);
     }
 
@@ -218,9 +280,9 @@ QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
         unsigned char *data = uidInPayload ? reinterpret_cast<unsigned char *>(payload.data())
                                            : reinterpret_cast<unsigned char *>(&canFrameId);
         if (!d->fillUniqueId(data, bitsSize, uniqueId)) {
-            d->setError(Error::Encoding,
-                        QObject::tr("Failed to encode unique id %1 into the frame").
-                        arg(qToUnderlying(uniqueId)));
+            d->state.setError(Error::Encoding,
+                              QObject::tr("Failed to encode unique id %1 into the frame").
+                              arg(qToUnderlying(uniqueId)));
             return QCanBusFrame(QCanBusFrame::InvalidFrame);
         }
     }
@@ -248,23 +310,23 @@ QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
     for (auto it = signalValues.cbegin(); it != signalValues.cend(); ++it) {
         const QString &signalName = it.key();
         if (!descriptionsHash.contains(signalName)) {
-            d->addWarning(QObject::tr("Skipping signal %1. It is not found in "
-                                      "message description for unique id %2.").
-                          arg(signalName, QString::number(qToUnderlying(uniqueId))));
+            d->state.addWarning(QObject::tr("Skipping signal %1. It is not found in "
+                                            "message description for unique id %2.").
+                                arg(signalName, QString::number(qToUnderlying(uniqueId))));
             continue;
         }
 
         const auto &signalDesc = descriptionsHash.value(signalName);
         if (!signalDesc.isValid()) {
-            d->addWarning(QObject::tr("Skipping signal %1. Its description is invalid.").
-                          arg(signalName));
+            d->state.addWarning(QObject::tr("Skipping signal %1. Its description is invalid.").
+                                arg(signalName));
             continue;
         }
 
         // check for multiplexor prerequisites
         if (!checkMuxValues(signalDesc, signalValues)) {
-            d->addWarning(QObject::tr("Skipping signal %1. Proper multiplexor values not found.").
-                          arg(signalName));
+            d->state.addWarning(QObject::tr("Skipping signal %1. Proper multiplexor values "
+                                            "not found.").arg(signalName));
             continue;
         }
 
@@ -275,8 +337,8 @@ QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
         const auto signalDataEnd = extractMaxBitNum(signalDesc.startBit(), signalDesc.bitLength(),
                                                     signalDesc.dataEndian());
         if (signalDataEnd >= maxDataLength) {
-            d->addWarning(QObject::tr("Skipping signal %1. Its length exceeds the expected "
-                                      "message length.").arg(signalName));
+            d->state.addWarning(QObject::tr("Skipping signal %1. Its length exceeds the expected "
+                                            "message length.").arg(signalName));
             continue;
         }
 
@@ -288,6 +350,67 @@ QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
     return QCanBusFrame(canFrameId, payload);
 }
 
+/*!
+    \since 6.9
+    \overload
+
+    Constructs a CAN data frame for the message with the unique identifier
+    \a uniqueId from the signal \a values, and stores it in \a frame.
+
+    The values are read from the same positions, which the
+    \l {parseFrame(const QCanBusFrame &, QSpan<double>)}{parseFrame()}
+    overloads write them to, see \l signalIndex(). So \a values usually
+    has \l signalIndexCount() elements. It must at least contain the indices
+    of all signals of the message.
+
+    The frame is created the same way as in \l prepareFrame(QtCanBus::UniqueId,
+    const QVariantMap &), with the value of every signal of the message
+    taken from \a values. Multiplexed signals are only written if the values
+    of their multiplexor signals match. Signals with
+    \l {QtCanBus::DataFormat::}{AsciiString} data format are not written.
+
+    The message descriptions are analyzed once, when they are set. Together
+    with reusing the payload of \a frame, this makes the method suitable for
+    sending a large number of frames, e.g. when simulating the cyclic
+    messages of a device. If the payload of \a frame is not shared with
+    other frames, no memory is allocated.
+
+    Returns the number of signal values written into the frame, or \c -1 if
+    an error occurred. In such cases, \a frame is not modified, and the
+    \l error() and \l errorString() methods can be used to get information
+    about the errors.
+
+    \note Calling this method clears all previous errors and warnings.
+
+    \sa signalIndex(), parseFrame()
+*/
+qsizetype QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
+                                           QSpan<const double> values, QCanBusFrame *frame)
+{
+    return d->prepareFrameFrom(uniqueId, values, frame, d->state);
+}
+
+/*!
+    \since 6.9
+    \overload
+
+    Constructs a CAN data frame for the message with the unique identifier
+    \a uniqueId from the integer signal \a values, and stores it in \a frame.
+
+    This method works like \l {prepareFrame(QtCanBus::UniqueId, QSpan<const double>,
+    QCanBusFrame *)}{prepareFrame()}, but reads integer values. Values of
+    unsigned signals above \c {std::numeric_limits<qint64>::max()} are
+    expected in two's complement, like \l {parseFrame(const QCanBusFrame &,
+    QSpan<qint64>)}{parseFrame()} returns them.
+
+    \sa signalIndex(), parseFrame()
+*/
+qsizetype QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
+                                           QSpan<const qint64> values, QCanBusFrame *frame)
+{
+    return d->prepareFrameFrom(uniqueId, values, frame, d->state);
+}
+
 /*!
     Returns the last error.
 
@@ -295,7 +418,7 @@ QCanBusFrame QCanFrameProcessor::prepareFrame(QtCanBus::UniqueId uniqueId,
 */
 QCanFrameProcessor::Error QCanFrameProcessor::error() const
 {
-    return d->error;
+    return d->state.error;
 }
 
 /*!
@@ -305,7 +428,7 @@ QCanFrameProcessor::Error QCanFrameProcessor::error() const
 */
 QString QCanFrameProcessor::errorString() const
 {
-    return d->errorString;
+    return d->state.errorString;
 }
 
 /*!
@@ -316,7 +439,7 @@ QString QCanFrameProcessor::errorString() const
 */
 QStringList QCanFrameProcessor::warnings() const
 {
-    return d->warnings;
+    return d->state.warnings;
 }
 
 /*!
@@ -341,15 +464,23 @@ QList<QCanMessageDescription> QCanFrameProcessor::messageDescriptions() const
     description will be used.
 
     If the parser already had a message description with the same unique id, it
-    will be overwritten.
+    will be overwritten. The signals of the overwritten message keep their
+    \l {signalIndex()}{signal indices}, if the new description has signals
+    with the same names.
 
     \sa messageDescriptions(), setMessageDescriptions(),
     clearMessageDescriptions()
 */
 void QCanFrameProcessor::addMessageDescriptions(const QList<QCanMessageDescription> &descriptions)
 {
-    for (const auto &desc : descriptions)
+    for (const auto &desc : descriptions) {
         d->messages.insert(desc.uniqueId(), desc);
+        QCanMessageDecoder decoder = QCanFrameProcessorPrivate::createMessageDecoder(desc);
+        const auto oldDecoder = d->decoders.constFind(desc.uniqueId());
+        d->assignSignalIndices(decoder, oldDecoder != d->decoders.cend() ? &oldDecoder.value()
+                                                                         : nullptr);
+        d->decoders.insert(desc.uniqueId(), std::move(decoder));
+    }
 }
 
 /*!
@@ -362,9 +493,71 @@ void QCanFrameProcessor::addMessageDescriptions(const QList<QCanMessageDescripti
 void QCanFrameProcessor::setMessageDescriptions(const QList<QCanMessageDescription> &descriptions)
 {
     d->messages.clear();
+    d->decoders.clear();
+    d->clearSignalIndices();
     addMessageDescriptions(descriptions);
 }
 
+/*!
+    \since 6.9
+
+    Replaces current message descriptions used by this frame processor with the
+    new message descriptions \a descriptions, like \l setMessageDescriptions()
+    does, but keeps the prepared decoding data of the messages which did not
+    change. Returns the number of message descriptions which were added,
+    changed, or removed.
+
+    Use this method to apply a reloaded set of message descriptions in which
+    only a few messages changed, so that the other messages are not prepared
+    once again. The messages which did not change keep their
+    \l {signalIndex()}{signal indices}. The signals of a changed message
+    keep their indices if the message still has signals with the same names.
+    The indices of the signals of removed messages, and of removed signals,
+    are reused for the signals which are added.
+
+    If some message descriptions have repeated unique ids, only the last
+    description will be used.
+
+    \sa setMessageDescriptions(), signalIndex()
+*/
+qsizetype
+QCanFrameProcessor::updateMessageDescriptions(const QList<QCanMessageDescription> &descriptions)
+{
+    QHash<QtCanBus::UniqueId, QCanMessageDescription> newMessages;
+    newMessages.reserve(descriptions.size());
+    for (const auto &desc : descriptions)
+        newMessages.insert(desc.uniqueId(), desc);
+
+    qsizetype changeCount = 0;
+    for (auto it = d->messages.begin(); it != d->messages.end();) {
+        if (!newMessages.contains(it.key())) {
+            d->releaseSignalIndices(d->decoders.take(it.key()));
+            it = d->messages.erase(it);
+            ++changeCount;
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto &desc : std::as_const(newMessages)) {
+        const QtCanBus::UniqueId uid = desc.uniqueId();
+        const auto oldMessage = d->messages.constFind(uid);
+        if (oldMessage != d->messages.cend()
+                && QCanFrameProcessorPrivate::isSameMessage(oldMessage.value(), desc)) {
+            continue;
+        }
+
+        QCanMessageDecoder decoder = QCanFrameProcessorPrivate::createMessageDecoder(desc);
+        const auto oldDecoder = d->decoders.constFind(uid);
+        d->assignSignalIndices(decoder, oldDecoder != d->decoders.cend() ? &oldDecoder.value()
+                                                                         : nullptr);
+        d->messages.insert(uid, desc);
+        d->decoders.insert(uid, std::move(decoder));
+        ++changeCount;
+    }
+    return changeCount;
+}
+
 /*!
     Removes all message descriptions for this frame processor.
 
@@ -374,6 +567,8 @@ void QCanFrameProcessor::setMessageDescriptions(const QList<QCanMessageDescripti
 void QCanFrameProcessor::clearMessageDescriptions()
 {
     d->messages.clear();
+    d->decoders.clear();
+    d->clearSignalIndices();
 }
 
 /*!
@@ -402,6 +597,23 @@ QCanUniqueIdDescription QCanFrameProcessor::uniqueIdDescription() const
 void QCanFrameProcessor::setUniqueIdDescription(const QCanUniqueIdDescription &description)
 {
     d->uidDescription = description;
+
+    // The unique id is extracted like an unsigned signal without value conversions.
+    QCanSignalDescription uidSignal;
+    uidSignal.setDataSource(description.source());
+    uidSignal.setDataEndian(description.endian());
+    uidSignal.setStartBit(description.startBit());
+    uidSignal.setBitLength(description.bitLength());
+    uidSignal.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+    d->uidDecoder = QCanFrameProcessorPrivate::createSignalDecoder(uidSignal);
+
+    // On little endian hosts, the frame id is stored like the little endian
+    // word that the decoder loads, so the unique id can be shifted out of it
+    // directly.
+    d->uidFromFrameIdBits = QSysInfo::ByteOrder == QSysInfo::LittleEndian
+            && !d->uidDecoder.fromPayload
+            && d->uidDecoder.method == QCanSignalDecoder::Method::LittleEndianWord
+            && d->uidDecoder.maxBit < 29;
 }
 
 /*!
@@ -435,151 +647,460 @@ void QCanFrameProcessor::setUniqueIdDescription(const QCanUniqueIdDescription &d
 */
 QCanFrameProcessor::ParseResult QCanFrameProcessor::parseFrame(const QCanBusFrame &frame)
 {
-    d->resetErrors();
+    return d->parseFrame(frame, d->state);
+}
 
-    if (!frame.isValid()) {
-        d->setError(Error::InvalidFrame, QObject::tr("Invalid frame."));
-        return {};
-    }
-    if (frame.frameType() != QCanBusFrame::DataFrame) {
-        d->setError(Error::UnsupportedFrameFormat, QObject::tr("Unsupported frame format."));
-        return {};
-    }
-    if (!d->uidDescription.isValid()) {
-        d->setError(Error::Decoding,
-                    QObject::tr("No valid unique identifier description is specified."));
-        return {};
-    }
+/*!
+    \since 6.9
+    \overload
 
-    const auto uidOpt = d->extractUniqueId(frame);
-    if (!uidOpt.has_value()) {
-        d->setError(Error::Decoding,
-                    QObject::tr("Failed to extract unique id from the frame."));
-        return {};
-    }
+    Parses the frame \a frame using the specified message descriptions, and
+    writes the signal values into \a values.
 
-    const auto uniqueId = uidOpt.value();
-    if (!d->messages.contains(uniqueId)) {
-        d->setError(Error::Decoding,
-                    QObject::tr("Could not find a message description for unique id %1.").
-                    arg(qToUnderlying(uniqueId)));
-        return {};
-    }
+    The unique identifier and the message description are determined the same
+    way as in \l parseFrame(const QCanBusFrame &). Each signal value is then
+    written to \a values at the position returned by \l signalIndex(), so
+    \a values usually has \l signalIndexCount() elements, and is reused for
+    all frames. It must at least contain the indices of all signals of the
+    message that is described by the frame.
 
-    const auto message = d->messages.value(uniqueId);
-    if (message.size() != frame.payload().size()) {
-        d->setError(Error::Decoding,
-                    QObject::tr("Payload size does not match message description. "
-                                "Actual size = %1, expected size = %2.").
-                    arg(frame.payload().size()).arg(message.size()));
-        return {};
-    }
+    Integer values are converted to \c double. The values of the
+    signals which are not part of the frame, because their multiplexor
+    conditions are not met, are not modified. The same applies to signals
+    with \l {QtCanBus::DataFormat::}{AsciiString} data format.
 
-    QVariantMap parsedSignals;
-    // The multiplexor signals can form a complex dependency, so we can't
-    // simply iterate through the signal descriptions in a natural order.
-    // Instead, we first need to process all signals with no dependency on
-    // other multiplexors, then handle the signals that have dependency on
-    // already parsed signals, and so on, until we parse all signals.
-    // One potential problem here is that the dependencies can be specified
-    // incorrectly (for example, we can have circular dependencies, or
-    // dependencies on non-existent signal), so we need to come up with a
-    // reasonable condition to stop.
-
-    auto seenNeededSignals = [](const QCanSignalDescription &desc,
-                                const QVariantMap &parsedSignals) -> bool {
-        const auto muxSignals = desc.multiplexSignals();
-        if (muxSignals.isEmpty())
-            return true;
-        const auto *descPrivate = QCanSignalDescriptionPrivate::get(desc);
-        for (auto it = muxSignals.cbegin(); it != muxSignals.cend(); ++it) {
-            const auto &name = it.key();
-            const auto &ranges = it.value();
-            if (!parsedSignals.contains(name)
-                    || !descPrivate->muxValueInRange(parsedSignals.value(name), ranges)) {
-                return false;
-            }
-        }
-        return true;
-    };
+    Unlike \l parseFrame(const QCanBusFrame &), this method does not
+    allocate memory when decoding valid frames, so it is suitable for
+    processing a large number of frames.
 
-    auto descriptionsHash = QCanMessageDescriptionPrivate::get(message)->messageSignals;
-    while (true) {
-        QList<QString> newNames;
-        for (const auto &desc : std::as_const(descriptionsHash)) {
-            if (seenNeededSignals(desc, parsedSignals)) {
-                newNames.push_back(desc.name());
-                if (!desc.isValid()) {
-                    d->addWarning(QObject::tr("Skipping signal %1 in message with unique id %2"
-                                              " because its description is invalid.").
-                                  arg(desc.name(), QString::number(qToUnderlying(uniqueId))));
-                    continue;
-                }
-                const QVariant value = d->decodeSignal(frame, desc);
-                if (value.isValid())
-                    parsedSignals.insert(desc.name(), value);
+    Returns the number of signal values written to \a values, or \c -1 if
+    an error occurred. In such cases, the \l error() and \l errorString()
+    methods can be used to get information about the errors.
+
+    \note Calling this method clears all previous errors and warnings.
+
+    \sa signalIndex(), signalIndexCount()
+*/
+qsizetype QCanFrameProcessor::parseFrame(const QCanBusFrame &frame, QSpan<double> values)
+{
+    return d->parseFrameInto(frame, values, d->state);
+}
+
+/*!
+    \since 6.9
+    \overload
+
+    Parses the frame \a frame using the specified message descriptions, and
+    writes the signal values into \a values.
+
+    This method works like \l {parseFrame(const QCanBusFrame &, QSpan<double>)}
+    {parseFrame()}, but writes integer values. Values of unsigned signals
+    above \c {std::numeric_limits<qint64>::max()} are stored in two's
+    complement and can be restored by casting them to \c quint64.
+    Floating point values, and values with \l {QCanSignalDescription::factor}
+    {factor}, \l {QCanSignalDescription::offset}{offset} or
+    \l {QCanSignalDescription::scaling}{scaling}, are rounded to the nearest
+    integer.
+
+    \sa signalIndex(), signalIndexCount()
+*/
+qsizetype QCanFrameProcessor::parseFrame(const QCanBusFrame &frame, QSpan<qint64> values)
+{
+    return d->parseFrameInto(frame, values, d->state);
+}
+
+/*!
+    \since 6.9
+
+    Decodes the signal with the index \a signalIndex from multiple frames of
+    the message with the unique identifier \a uniqueId, and writes its
+    values into \a values.
+
+    The \a payloads contain the payloads of the frames one after another,
+    so their size must be a multiple of the \l {QCanMessageDescription::size}
+    {size} of the message. The value of the signal in the \c{i}-th payload
+    is written to the \c{i}-th element of \a values. To decode all signals
+    of the message, call this method once per signal.
+
+    This method is meant for the offline analysis of recorded traces. The
+    payloads are processed in bulk, and the value conversion of integer
+    signals is vectorized, if the CPU supports it.
+
+    The values are converted to \c double, like in \l {parseFrame(const
+    QCanBusFrame &, QSpan<double>)}{parseFrame()}. If the multiplexor
+    conditions of the signal are not met in a frame, its value is \c NaN.
+    Only signals from the payload with a numeric data format can be decoded.
+
+    Returns the number of values written to \a values, or \c -1 if an error
+    occurred. In such cases, the \l error() and \l errorString() methods
+    can be used to get information about the errors.
+
+    \note Calling this method clears all previous errors and warnings.
+
+    \sa signalIndex(), parseFrame()
+*/
+qsizetype QCanFrameProcessor::parseColumn(QtCanBus::UniqueId uniqueId, qsizetype signalIndex,
+                                          QByteArrayView payloads, QSpan<double> values)
+{
+    return d->parseColumn(uniqueId, signalIndex, payloads, values, d->state);
+}
+
+/*!
+    \since 6.9
+
+    Decodes the frame \a frame the same way as \l parseFrame() does, but
+    returns the error and the warnings as part of the result, instead of
+    storing them in the processor.
+
+    This method does not modify the processor, so it can be called from
+    multiple threads at the same time, as long as the message descriptions
+    and the unique identifier description are not modified concurrently.
+
+    \sa decodeFrames(), parseFrame()
+*/
+QCanFrameProcessor::FrameResult QCanFrameProcessor::decodeFrame(const QCanBusFrame &frame) const
+{
+    QCanFrameProcessorState state;
+    return d->decodeFrame(frame, state);
+}
+
+/*!
+    \since 6.9
+
+    Decodes all \a frames, and returns their results in the same order.
+    Each result holds the decoded values, as well as the error and the
+    warnings of its frame, see \l decodeFrame().
+
+    Large batches of frames are split into chunks, which are decoded by
+    multiple threads. The calling thread takes part in the decoding, and
+    this method returns when all frames are decoded.
+
+    Like \l decodeFrame(), this method does not modify the processor. The
+    message descriptions and the unique identifier description must not be
+    modified while it runs.
+
+    \sa decodeFrame(), parseFrame()
+*/
+QList<QCanFrameProcessor::FrameResult>
+QCanFrameProcessor::decodeFrames(QSpan<const QCanBusFrame> frames) const
+{
+    const qsizetype count = qsizetype(frames.size());
+    QList<FrameResult> results(count);
+    FrameResult *out = results.data();
+
+#if QT_CONFIG(thread)
+    // Big enough to make the synchronization cost negligible
+    constexpr qsizetype ChunkSize = 1024;
+    const qsizetype chunkCount = (count + ChunkSize - 1) / ChunkSize;
+    if (chunkCount > 1) {
+        std::atomic<qsizetype> nextChunk = 0;
+        auto decodeRemainingChunks = [&] {
+            // The scratch space of the state is reused for all frames
+            QCanFrameProcessorState state;
+            for (qsizetype chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                const qsizetype end = qMin(count, (chunk + 1) * ChunkSize);
+                for (qsizetype i = chunk * ChunkSize; i < end; ++i)
+                    out[i] = d->decodeFrame(frames[i], state);
             }
-        }
-        for (const auto &name : std::as_const(newNames))
-            descriptionsHash.remove(name);
-        if (newNames.isEmpty() || descriptionsHash.isEmpty()) {
-            // We either processed all signals, or failed to process more during
-            // the last loop. The latter means that the multiplexor conditions
-            // do not match for the rest of the signals, which is fine and will
-            // always happen when multiplexing
-            break;
-        }
+        };
+        // A separate pool, so that we never wait for the tasks of others.
+        // The calling thread decodes the frames as well.
+        QThreadPool pool;
+        const qsizetype workerCount = qMin<qsizetype>(QThread::idealThreadCount(),
+                                                      chunkCount) - 1;
+        for (qsizetype i = 0; i < workerCount; ++i)
+            pool.start(decodeRemainingChunks);
+        decodeRemainingChunks();
+        pool.waitForDone();
+        return results;
     }
+#endif
 
-    return {uniqueId, parsedSignals};
+    QCanFrameProcessorState state;
+    for (qsizetype i = 0; i < count; ++i)
+        out[i] = d->decodeFrame(frames[i], state);
+    return results;
+}
+
+/*!
+    \since 6.9
+
+    Returns the index of the signal \a signalName in the message with the
+    unique identifier \a uniqueId, or \c -1 if there is no such signal.
+
+    The signal index determines where the value of the signal is written by
+    the \l {parseFrame(const QCanBusFrame &, QSpan<double>)}{parseFrame()}
+    overloads taking a span of values, and where it is read from by the
+    corresponding \l {prepareFrame(QtCanBus::UniqueId, QSpan<const double>,
+    QCanBusFrame *)}{prepareFrame()} overloads. The indices of all signals are
+    in the range from \c 0 to \l signalIndexCount() - 1, so the lookup can
+    be done once, after setting the message descriptions.
+
+    The indices stay valid until the message descriptions are
+    \l {setMessageDescriptions()}{set} or \l {clearMessageDescriptions()}
+    {cleared}. Adding a message description with an already known unique
+    identifier keeps the indices of the signals whose names did not change.
+    The indices of the signals which are removed this way are reused for
+    signals which are added later.
+
+    Signals with multiplexor dependencies which can never be fulfilled do
+    not have an index.
+
+    \sa signalIndexCount(), addMessageDescriptions()
+*/
+qsizetype QCanFrameProcessor::signalIndex(QtCanBus::UniqueId uniqueId,
+                                          const QString &signalName) const
+{
+    const auto message = d->decoders.constFind(uniqueId);
+    if (message == d->decoders.cend())
+        return -1;
+
+    const auto &signalDecoders = message->signalDecoders;
+    for (qsizetype i = 0; i < signalDecoders.size(); ++i) {
+        if (signalDecoders.at(i).name == signalName)
+            return signalDecoders.at(i).signalIndex;
+    }
+    return -1;
+}
+
+/*!
+    \since 6.9
+
+    Returns the size of the range of signal indices. A span of this size can
+    hold the values of all signals of all messages.
+
+    The indices of removed signals are reused for new signals, so the range
+    does not grow when message descriptions are replaced again and again.
+    It can contain indices which are currently not used by any signal.
+
+    \sa signalIndex(), parseFrame()
+*/
+qsizetype QCanFrameProcessor::signalIndexCount() const
+{
+    return d->signalIndexCount;
 }
 
 /* QCanFrameProcessorPrivate implementation */
 
-void QCanFrameProcessorPrivate::resetErrors()
+void QCanFrameProcessorState::resetErrors()
 {
     error = QCanFrameProcessor::Error::None;
     errorString.clear();
     warnings.clear();
 }
 
-void QCanFrameProcessorPrivate::setError(QCanFrameProcessor::Error err, const QString &desc)
+void QCanFrameProcessorState::setError(QCanFrameProcessor::Error err, const QString &desc)
 {
     error = err;
     errorString = desc;
 }
 
-void QCanFrameProcessorPrivate::addWarning(const QString &warning)
+void QCanFrameProcessorState::addWarning(const QString &warning)
 {
     warnings.push_back(warning);
 }
 
-QVariant QCanFrameProcessorPrivate::decodeSignal(const QCanBusFrame &frame,
-                                                 const QCanSignalDescription &signalDesc)
+const QCanMessageDecoder *
+QCanFrameProcessorPrivate::findDecoder(const QCanBusFrame &frame, QtCanBus::UniqueId *uniqueId,
+                                       QCanFrameProcessorState &state) const
+{
+    using Error = QCanFrameProcessor::Error;
+
+    if (!frame.isValid()) {
+        state.setError(Error::InvalidFrame, QObject::tr("Invalid frame."));
+        return nullptr;
+    }
+    if (frame.frameType() != QCanBusFrame::DataFrame) {
+        state.setError(Error::UnsupportedFrameFormat, QObject::tr("Unsupported frame format."));
+        return nullptr;
+    }
+    if (!uidDescription.isValid()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("No valid unique identifier description is specified."));
+        return nullptr;
+    }
+
+    const auto uidOpt = extractUniqueId(frame);
+    if (!uidOpt.has_value()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Failed to extract unique id from the frame."));
+        return nullptr;
+    }
+
+    *uniqueId = uidOpt.value();
+    const auto message = decoders.constFind(*uniqueId);
+    if (message == decoders.cend()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Could not find a message description for unique id %1.").
+                       arg(qToUnderlying(*uniqueId)));
+        return nullptr;
+    }
+
+    if (message->payloadSize != frame.payloadView().size()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Payload size does not match message description. "
+                                   "Actual size = %1, expected size = %2.").
+                       arg(frame.payloadView().size()).arg(message->payloadSize));
+        return nullptr;
+    }
+
+    return &message.value();
+}
+
+QCanFrameProcessor::ParseResult
+QCanFrameProcessorPrivate::parseFrame(const QCanBusFrame &frame,
+                                      QCanFrameProcessorState &state) const
 {
-    const auto signalDataEnd = extractMaxBitNum(signalDesc.startBit(), signalDesc.bitLength(),
-                                                signalDesc.dataEndian());
-    const bool dataFromPayload =
-            signalDesc.dataSource() == QtCanBus::DataSource::Payload;
+    state.resetErrors();
+
+    QtCanBus::UniqueId uniqueId{0};
+    const QCanMessageDecoder *message = findDecoder(frame, &uniqueId, state);
+    if (!message)
+        return {};
+
+    // The multiplexor signals can form a complex dependency. The decoders are
+    // sorted so that all multiplexors of a signal are processed before the
+    // signal itself. Signals with dependencies which can never be fulfilled
+    // (circular dependencies, or dependencies on non-existent signals) are
+    // not part of the decoders at all, see createMessageDecoder().
+    QVariantMap parsedSignals;
+    const qsizetype signalCount = message->signalDecoders.size();
+    state.decodedValues.resize(signalCount);
+    for (qsizetype i = 0; i < signalCount; ++i) {
+        const QCanSignalDecoder &decoder = message->signalDecoders.at(i);
+        QVariant &value = state.decodedValues[i];
+        value = QVariant();
+        // If the multiplexor conditions do not match, the signal is not
+        // part of this frame, which is fine and will always happen when
+        // multiplexing
+        if (!muxConditionsMet(decoder, state))
+            continue;
+        if (!decoder.valid) {
+            state.addWarning(QObject::tr("Skipping signal %1 in message with unique id %2"
+                                         " because its description is invalid.").
+                             arg(decoder.name, QString::number(qToUnderlying(uniqueId))));
+            continue;
+        }
+        value = decodeSignal(frame, decoder, state);
+        if (value.isValid())
+            parsedSignals.insert(decoder.name, value);
+    }
+
+    return {uniqueId, parsedSignals};
+}
+
+QCanFrameProcessor::FrameResult
+QCanFrameProcessorPrivate::decodeFrame(const QCanBusFrame &frame,
+                                       QCanFrameProcessorState &state) const
+{
+    auto [uniqueId, signalValues] = parseFrame(frame, state);
+    return { uniqueId, std::move(signalValues), state.error, state.errorString, state.warnings };
+}
+
+template <typename T>
+qsizetype QCanFrameProcessorPrivate::parseFrameInto(const QCanBusFrame &frame, QSpan<T> values,
+                                                    QCanFrameProcessorState &state) const
+{
+    state.resetErrors();
+
+    QtCanBus::UniqueId uniqueId{0};
+    const QCanMessageDecoder *message = findDecoder(frame, &uniqueId, state);
+    if (!message)
+        return -1;
+
+    const qsizetype signalCount = message->signalDecoders.size();
+    if (qsizetype(values.size()) < message->signalIndexEnd) {
+        state.setError(QCanFrameProcessor::Error::Decoding,
+                       QObject::tr("Not enough space for the signal values of unique id %1. "
+                                   "Actual size = %2, expected size = %3.").
+                       arg(qToUnderlying(uniqueId)).arg(values.size()).
+                       arg(message->signalIndexEnd));
+        return -1;
+    }
+
+    const QByteArrayView payload = frame.payloadView();
+    const auto frameId = frame.frameId();
+    qsizetype count = 0;
+    // Only the values of the multiplexor signals are kept as QVariant. These
+    // are numbers, which QVariant stores without allocating.
+    state.decodedValues.resize(signalCount);
+    for (qsizetype i = 0; i < signalCount; ++i) {
+        const QCanSignalDecoder &decoder = message->signalDecoders.at(i);
+        QVariant &muxValue = state.decodedValues[i];
+        muxValue = QVariant();
+        if (!muxConditionsMet(decoder, state))
+            continue;
+        if (!decoder.valid) {
+            state.addWarning(QObject::tr("Skipping signal %1 in message with unique id %2"
+                                         " because its description is invalid.").
+                             arg(decoder.name, QString::number(qToUnderlying(uniqueId))));
+            continue;
+        }
+        if (!signalFits(frame, decoder, state))
+            continue;
+
+        const unsigned char *data = decoder.fromPayload
+                ? reinterpret_cast<const unsigned char *>(payload.data())
+                : reinterpret_cast<const unsigned char *>(&frameId);
+        const qsizetype dataSize = decoder.fromPayload ? payload.size()
+                                                       : qsizetype(sizeof(frameId));
+        if (decoder.isMultiplexor)
+            muxValue = decodeValue(decoder, data, dataSize);
+        if (decoder.format == QtCanBus::DataFormat::AsciiString)
+            continue;
+        values[decoder.signalIndex] = decodeNumber<T>(decoder, data, dataSize);
+        ++count;
+    }
+    return count;
+}
 
+bool QCanFrameProcessorPrivate::signalFits(const QCanBusFrame &frame,
+                                           const QCanSignalDecoder &decoder,
+                                           QCanFrameProcessorState &state) const
+{
     const auto frameIdLength = frame.hasExtendedFrameFormat() ? 29 : 11;
-    const auto maxDataLength = dataFromPayload ? frame.payload().size() * 8
-                                               : frameIdLength;
+    const auto maxDataLength = decoder.fromPayload ? frame.payloadView().size() * 8
+                                                   : frameIdLength;
+
+    if (decoder.maxBit >= maxDataLength) {
+        state.addWarning(QObject::tr("Skipping signal %1 in message with unique id %2. "
+                                     "Its expected length exceeds the data length.").
+                         arg(decoder.name, QString::number(frame.frameId())));
+        return false;
+    }
+    return true;
+}
 
-    if (signalDataEnd >= maxDataLength) {
-        addWarning(QObject::tr("Skipping signal %1 in message with unique id %2. "
-                               "Its expected length exceeds the data length.").
-                   arg(signalDesc.name(), QString::number(frame.frameId())));
+QVariant QCanFrameProcessorPrivate::decodeSignal(const QCanBusFrame &frame,
+                                                 const QCanSignalDecoder &decoder,
+                                                 QCanFrameProcessorState &state) const
+{
+    if (!signalFits(frame, decoder, state))
         return QVariant();
-    }
 
-    const QByteArray payload = frame.payload();
+    const QByteArrayView payload = frame.payloadView();
     const auto frameId = frame.frameId();
-    const unsigned char *data = dataFromPayload
+    const unsigned char *data = decoder.fromPayload
             ? reinterpret_cast<const unsigned char *>(payload.data())
             : reinterpret_cast<const unsigned char *>(&frameId);
+    const qsizetype dataSize = decoder.fromPayload ? payload.size() : qsizetype(sizeof(frameId));
+
+    return decodeValue(decoder, data, dataSize);
+}
+
+bool QCanFrameProcessorPrivate::muxConditionsMet(const QCanSignalDecoder &decoder,
+                                                 const QCanFrameProcessorState &state) const
+{
+    if (decoder.muxConditions.isEmpty())
+        return true;
 
-    return parseData(data, signalDesc);
+    const auto *descPrivate = QCanSignalDescriptionPrivate::get(decoder.description);
+    for (const auto &[index, ranges] : decoder.muxConditions) {
+        const QVariant &muxValue = state.decodedValues.at(index);
+        if (!muxValue.isValid() || !descPrivate->muxValueInRange(muxValue, ranges))
+            return false;
+    }
+    return true;
 }
 
 static bool needValueConversion(const QCanSignalDescription &signalDesc)
@@ -604,11 +1125,11 @@ static double convertFromCanValue(T value, const QCanSignalDescription &signalDe
     return result;
 }
 
-static double convertToCanValue(const QVariant &value, const QCanSignalDescription &signalDesc)
+static double convertToCanValue(double value, const QCanSignalDescription &signalDesc)
 {
     // Checks for 0 are done in the corresponding setters, so we can divide
     // safely.
-    double result = value.toDouble();
+    double result = value;
     if (!qIsNaN(signalDesc.scaling()))
         result /= signalDesc.scaling();
 
@@ -862,7 +1383,7 @@ static QVariant parseAscii(const unsigned char *data, const QCanSignalDescriptio
 }
 
 QVariant QCanFrameProcessorPrivate::parseData(const unsigned char *data,
-                                              const QCanSignalDescription &signalDesc)
+                                              const QCanSignalDescription &signalDesc) const
 {
     // We assume that signal's length does not exceed data size.
     // That is checked as a precondition to calling this method, so we do not
@@ -882,6 +1403,476 @@ QVariant QCanFrameProcessorPrivate::parseData(const unsigned char *data,
     Q_UNREACHABLE();
 }
 
+// Calls \a visitor with the value of the signal, as extracted from \a word.
+template <typename Visitor>
+static auto visitWordValue(const QCanSignalDecoder &decoder, quint64 word, Visitor visitor)
+{
+    switch (decoder.format) {
+    case QtCanBus::DataFormat::SignedInteger: {
+        // fill the most significant bits with the sign bit
+        const quint64 signBit = (decoder.mask >> 1) + 1;
+        return visitor(qint64((word & signBit) ? (word | ~decoder.mask) : word));
+    }
+    case QtCanBus::DataFormat::UnsignedInteger:
+        return visitor(word);
+    case QtCanBus::DataFormat::Float: {
+        const quint32 bits = quint32(word);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return visitor(value);
+    }
+    case QtCanBus::DataFormat::Double: {
+        double value;
+        memcpy(&value, &word, sizeof(value));
+        return visitor(value);
+    }
+    case QtCanBus::DataFormat::AsciiString:
+        break; // always uses the generic method
+    }
+    Q_UNREACHABLE_RETURN(visitor(word));
+}
+
+template <typename T>
+static QVariant convertedValue(T value, const QCanSignalDecoder &decoder)
+{
+    if (decoder.convert)
+        return QVariant::fromValue(convertFromCanValue(value, decoder.description));
+
+    return QVariant::fromValue(value);
+}
+
+QVariant QCanFrameProcessorPrivate::decodeValue(const QCanSignalDecoder &decoder,
+                                                const unsigned char *data, qsizetype size) const
+{
+    if (decoder.method == QCanSignalDecoder::Method::Generic)
+        return parseData(data, decoder.description);
+
+    return visitWordValue(decoder, decoder.extractWord(data, size),
+                          [&decoder](auto value) { return convertedValue(value, decoder); });
+}
+
+template <typename T>
+static T numericValue(double value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return value;
+    else
+        return qIsFinite(value) ? T(std::llround(value)) : T(0);
+}
+
+template <typename T, typename V>
+static T numericValue(V value, const QCanSignalDecoder &decoder)
+{
+    if (decoder.convert)
+        return numericValue<T>(convertFromCanValue(value, decoder.description));
+    if constexpr (std::is_floating_point_v<V>)
+        return numericValue<T>(double(value));
+    else
+        return T(value);
+}
+
+template <typename T>
+T QCanFrameProcessorPrivate::decodeNumber(const QCanSignalDecoder &decoder,
+                                          const unsigned char *data, qsizetype size) const
+{
+    if (decoder.method == QCanSignalDecoder::Method::Generic) {
+        // The value conversion is already applied. Numeric QVariants are
+        // stored inline, so this does not allocate.
+        const QVariant value = parseData(data, decoder.description);
+        switch (value.typeId()) {
+        case QMetaType::LongLong:
+            return T(value.toLongLong());
+        case QMetaType::ULongLong:
+            return T(value.toULongLong());
+        default:
+            return numericValue<T>(value.toDouble());
+        }
+    }
+
+    return visitWordValue(decoder, decoder.extractWord(data, size),
+                          [&decoder](auto value) { return numericValue<T>(value, decoder); });
+}
+
+// The columns are processed in blocks, so that the raw words of a block stay
+// in the L1 cache between loading and converting them.
+static constexpr qsizetype ColumnBlockSize = 256;
+
+// Parameters of the conversion of raw integer words to physical values. The
+// conversion uses the same operations as convertFromCanValue(), with the
+// NaN factor, offset and scaling replaced by values which do not change the
+// result.
+struct QCanColumnConversion
+{
+    quint64 mask;
+    quint64 signBit; // 0 for unsigned signals
+    quint64 bias; // makes the signed values positive
+    double factor;
+    double offset;
+    double scaling;
+    quint8 shift;
+};
+
+// Converts integers below 2^52 to double by placing them into the mantissa
+// of 2^52, which avoids the int64 conversion instructions that SSE2 and AVX2
+// do not have.
+static constexpr quint64 DoubleExponent52 = Q_UINT64_C(0x4330000000000000);
+
+static void convertColumnScalar(const quint64 *words, double *values, qsizetype count,
+                                const QCanColumnConversion &c)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        const quint64 raw = (words[i] >> c.shift) & c.mask;
+        const qint64 value = qint64(raw ^ c.signBit) - qint64(c.signBit);
+        values[i] = (double(value) * c.factor + c.offset) * c.scaling;
+    }
+}
+
+#ifdef __SSE2__
+static void convertColumnSse2(const quint64 *words, double *values, qsizetype count,
+                              const QCanColumnConversion &c)
+{
+    const __m128i shift = _mm_cvtsi32_si128(c.shift);
+    const __m128i mask = _mm_set1_epi64x(qint64(c.mask));
+    const __m128i signBit = _mm_set1_epi64x(qint64(c.signBit));
+    const __m128i bias = _mm_set1_epi64x(qint64(c.bias));
+    const __m128i exponent = _mm_set1_epi64x(qint64(DoubleExponent52));
+    const __m128d magic = _mm_set1_pd(4503599627370496.0 + double(c.bias)); // 2^52 + bias
+    const __m128d factor = _mm_set1_pd(c.factor);
+    const __m128d offset = _mm_set1_pd(c.offset);
+    const __m128d scaling = _mm_set1_pd(c.scaling);
+
+    qsizetype i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i));
+        raw = _mm_and_si128(_mm_srl_epi64(raw, shift), mask);
+        raw = _mm_sub_epi64(_mm_xor_si128(raw, signBit), signBit); // sign extension
+        raw = _mm_or_si128(_mm_add_epi64(raw, bias), exponent);
+        __m128d value = _mm_sub_pd(_mm_castsi128_pd(raw), magic);
+        value = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(value, factor), offset), scaling);
+        _mm_storeu_pd(values + i, value);
+    }
+    convertColumnScalar(words + i, values + i, count - i, c);
+}
+#endif // __SSE2__
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static void convertColumnAvx2(const quint64 *words, double *values, qsizetype count,
+                              const QCanColumnConversion &c)
+{
+    const __m128i shift = _mm_cvtsi32_si128(c.shift);
+    const __m256i mask = _mm256_set1_epi64x(qint64(c.mask));
+    const __m256i signBit = _mm256_set1_epi64x(qint64(c.signBit));
+    const __m256i bias = _mm256_set1_epi64x(qint64(c.bias));
+    const __m256i exponent = _mm256_set1_epi64x(qint64(DoubleExponent52));
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0 + double(c.bias)); // 2^52 + bias
+    const __m256d factor = _mm256_set1_pd(c.factor);
+    const __m256d offset = _mm256_set1_pd(c.offset);
+    const __m256d scaling = _mm256_set1_pd(c.scaling);
+
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+        raw = _mm256_and_si256(_mm256_srl_epi64(raw, shift), mask);
+        raw = _mm256_sub_epi64(_mm256_xor_si256(raw, signBit), signBit); // sign extension
+        raw = _mm256_or_si256(_mm256_add_epi64(raw, bias), exponent);
+        __m256d value = _mm256_sub_pd(_mm256_castsi256_pd(raw), magic);
+        value = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(value, factor), offset), scaling);
+        _mm256_storeu_pd(values + i, value);
+    }
+    convertColumnScalar(words + i, values + i, count - i, c);
+}
+#endif // QT_COMPILER_SUPPORTS_HERE(AVX2)
+
+static void convertColumn(const quint64 *words, double *values, qsizetype count,
+                          const QCanColumnConversion &conversion)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return convertColumnAvx2(words, values, count, conversion);
+#endif
+#ifdef __SSE2__
+    return convertColumnSse2(words, values, count, conversion);
+#else
+    return convertColumnScalar(words, values, count, conversion);
+#endif
+}
+
+qsizetype QCanFrameProcessorPrivate::parseColumn(QtCanBus::UniqueId uniqueId,
+                                                 qsizetype signalIndex, QByteArrayView payloads,
+                                                 QSpan<double> values,
+                                                 QCanFrameProcessorState &state) const
+{
+    using Error = QCanFrameProcessor::Error;
+
+    state.resetErrors();
+
+    const auto message = decoders.constFind(uniqueId);
+    if (message == decoders.cend()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Could not find a message description for unique id %1.").
+                       arg(qToUnderlying(uniqueId)));
+        return -1;
+    }
+
+    const auto &signalDecoders = message->signalDecoders;
+    const auto signalDecoder = std::find_if(signalDecoders.cbegin(), signalDecoders.cend(),
+                                            [signalIndex](const QCanSignalDecoder &decoder) {
+        return decoder.signalIndex == signalIndex;
+    });
+    if (signalDecoder == signalDecoders.cend()) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Signal index %1 does not belong to the message with "
+                                   "unique id %2.").arg(signalIndex).arg(qToUnderlying(uniqueId)));
+        return -1;
+    }
+
+    const qsizetype payloadSize = message->payloadSize;
+    if (payloadSize == 0 || payloads.size() % payloadSize != 0) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Payload size does not match message description. "
+                                   "Actual size = %1, expected size = a multiple of %2.").
+                       arg(payloads.size()).arg(payloadSize));
+        return -1;
+    }
+
+    const qsizetype count = payloads.size() / payloadSize;
+    if (qsizetype(values.size()) < count) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Not enough space for the signal values of unique id %1. "
+                                   "Actual size = %2, expected size = %3.").
+                       arg(qToUnderlying(uniqueId)).arg(values.size()).arg(count));
+        return -1;
+    }
+
+    const QCanSignalDecoder &decoder = *signalDecoder;
+    if (!decoder.valid || !decoder.fromPayload || decoder.maxBit >= payloadSize * 8
+            || decoder.format == QtCanBus::DataFormat::AsciiString) {
+        state.setError(Error::Decoding,
+                       QObject::tr("Signal %1 in message with unique id %2 can not be decoded "
+                                   "from the payloads.").
+                       arg(decoder.name, QString::number(qToUnderlying(uniqueId))));
+        return -1;
+    }
+
+    const auto *data = reinterpret_cast<const unsigned char *>(payloads.data());
+    double *out = values.data();
+    const bool isInteger = decoder.format == QtCanBus::DataFormat::SignedInteger
+            || decoder.format == QtCanBus::DataFormat::UnsignedInteger;
+    const quint16 length = decoder.description.bitLength();
+    if (decoder.method != QCanSignalDecoder::Method::Generic && isInteger && length <= 52) {
+        const auto *signalDesc = QCanSignalDescriptionPrivate::get(decoder.description);
+        auto valueOr = [](double value, double defaultValue) {
+            return qIsNaN(value) ? defaultValue : value;
+        };
+        QCanColumnConversion conversion;
+        conversion.mask = decoder.mask;
+        conversion.signBit = decoder.format == QtCanBus::DataFormat::SignedInteger
+                ? (decoder.mask >> 1) + 1 : 0;
+        conversion.bias = conversion.signBit;
+        conversion.factor = valueOr(signalDesc->factor, 1.0);
+        conversion.offset = valueOr(signalDesc->offset, 0.0);
+        conversion.scaling = valueOr(signalDesc->scaling, 1.0);
+        conversion.shift = decoder.shift;
+
+        quint64 words[ColumnBlockSize];
+        for (qsizetype first = 0; first < count; first += ColumnBlockSize) {
+            const qsizetype blockSize = qMin(ColumnBlockSize, count - first);
+            for (qsizetype i = 0; i < blockSize; ++i)
+                words[i] = decoder.loadWord(data + (first + i) * payloadSize, payloadSize);
+            convertColumn(words, out + first, blockSize, conversion);
+        }
+    } else {
+        for (qsizetype i = 0; i < count; ++i)
+            out[i] = decodeNumber<double>(decoder, data + i * payloadSize, payloadSize);
+    }
+
+    if (decoder.muxConditions.isEmpty())
+        return count;
+
+    // Multiplexed signals are rare, so their conditions are checked per
+    // frame, by decoding the multiplexors which come before the signal.
+    const qsizetype index = signalDecoder - signalDecoders.cbegin();
+    state.decodedValues.resize(index);
+    for (qsizetype i = 0; i < count; ++i) {
+        const unsigned char *payload = data + i * payloadSize;
+        for (qsizetype j = 0; j < index; ++j) {
+            const QCanSignalDecoder &mux = signalDecoders.at(j);
+            QVariant &muxValue = state.decodedValues[j];
+            muxValue = QVariant();
+            if (mux.isMultiplexor && mux.valid && mux.fromPayload
+                    && mux.maxBit < payloadSize * 8 && muxConditionsMet(mux, state)) {
+                muxValue = decodeValue(mux, payload, payloadSize);
+            }
+        }
+        if (!muxConditionsMet(decoder, state))
+            out[i] = qQNaN();
+    }
+    return count;
+}
+
+QCanSignalDecoder
+QCanFrameProcessorPrivate::createSignalDecoder(const QCanSignalDescription &signalDesc)
+{
+    QCanSignalDecoder decoder;
+    decoder.description = signalDesc;
+    decoder.name = signalDesc.name();
+    decoder.format = signalDesc.dataFormat();
+    decoder.fromPayload = signalDesc.dataSource() == QtCanBus::DataSource::Payload;
+    decoder.valid = signalDesc.isValid();
+    decoder.convert = needValueConversion(signalDesc);
+
+    const quint16 start = signalDesc.startBit();
+    const quint16 length = signalDesc.bitLength();
+    decoder.maxBit = extractMaxBitNum(start, length, signalDesc.dataEndian());
+
+    bool fitsWord = false;
+    switch (decoder.format) {
+    case QtCanBus::DataFormat::SignedInteger:
+    case QtCanBus::DataFormat::UnsignedInteger:
+        fitsWord = length > 0 && length <= 64;
+        break;
+    case QtCanBus::DataFormat::Float:
+        fitsWord = length == 32;
+        break;
+    case QtCanBus::DataFormat::Double:
+        fitsWord = length == 64;
+        break;
+    case QtCanBus::DataFormat::AsciiString:
+        break;
+    }
+    if (!fitsWord)
+        return decoder;
+
+    decoder.mask = length == 64 ? ~quint64(0) : (quint64(1) << length) - 1;
+    decoder.byteOffset = start / 8;
+    if (signalDesc.dataEndian() == QSysInfo::Endian::LittleEndian) {
+        // The start bit is the LSB, the signal continues with the higher bits.
+        if (start % 8 + length <= 64) {
+            decoder.shift = start % 8;
+            decoder.method = QCanSignalDecoder::Method::LittleEndianWord;
+        }
+    } else {
+#ifdef USE_DBC_COMPATIBLE_BE_HANDLING
+        // The start bit is the MSB. When the bytes are loaded as a big endian
+        // word, the start byte becomes the most significant byte, and the
+        // signal bits are contiguous down to the LSB.
+        const int shift = 56 + start % 8 - (length - 1);
+        if (shift >= 0) {
+            decoder.shift = quint8(shift);
+            decoder.method = QCanSignalDecoder::Method::BigEndianWord;
+        }
+#endif // USE_DBC_COMPATIBLE_BE_HANDLING
+    }
+    return decoder;
+}
+
+QCanMessageDecoder
+QCanFrameProcessorPrivate::createMessageDecoder(const QCanMessageDescription &message)
+{
+    QCanMessageDecoder result;
+    result.payloadSize = message.size();
+
+    // Sort the signals, so that each signal comes after all its multiplexors.
+    // Signals which depend on a non-existent signal, or which have circular
+    // dependencies, can never be decoded and are left out.
+    QList<QCanSignalDescription> pending =
+            QCanMessageDescriptionPrivate::get(message)->messageSignals.values();
+    QHash<QString, qsizetype> indices;
+    while (!pending.isEmpty()) {
+        const qsizetype pendingCount = pending.size();
+        for (auto it = pending.begin(); it != pending.end();) {
+            const auto muxSignals = it->multiplexSignals();
+            bool ready = true;
+            for (auto mux = muxSignals.cbegin(); ready && mux != muxSignals.cend(); ++mux)
+                ready = indices.contains(mux.key());
+            if (!ready) {
+                ++it;
+                continue;
+            }
+
+            QCanSignalDecoder decoder = createSignalDecoder(*it);
+            for (auto mux = muxSignals.cbegin(); mux != muxSignals.cend(); ++mux) {
+                const qsizetype muxIndex = indices.value(mux.key());
+                result.signalDecoders[muxIndex].isMultiplexor = true;
+                decoder.muxConditions.append({ muxIndex, mux.value() });
+            }
+            indices.insert(decoder.name, result.signalDecoders.size());
+            result.signalDecoders.append(std::move(decoder));
+            it = pending.erase(it);
+        }
+        if (pending.size() == pendingCount)
+            break;
+    }
+
+    return result;
+}
+
+// Assigns an index to each signal of decoder. The signals keep the indices of the
+// signals with the same names in previous, the former decoder of the same message.
+void QCanFrameProcessorPrivate::assignSignalIndices(QCanMessageDecoder &decoder,
+                                                    const QCanMessageDecoder *previous)
+{
+    if (previous) {
+        QHash<QString, qsizetype> previousIndices;
+        previousIndices.reserve(previous->signalDecoders.size());
+        for (const QCanSignalDecoder &signalDecoder : previous->signalDecoders)
+            previousIndices.insert(signalDecoder.name, signalDecoder.signalIndex);
+
+        for (QCanSignalDecoder &signalDecoder : decoder.signalDecoders) {
+            const auto it = previousIndices.find(signalDecoder.name);
+            if (it != previousIndices.end()) {
+                signalDecoder.signalIndex = it.value();
+                previousIndices.erase(it);
+            }
+        }
+        // free the indices of the removed signals first, so that they are reused
+        for (qsizetype index : std::as_const(previousIndices))
+            releaseSignalIndex(index);
+    }
+
+    decoder.signalIndexEnd = 0;
+    for (QCanSignalDecoder &signalDecoder : decoder.signalDecoders) {
+        if (signalDecoder.signalIndex < 0) {
+            signalDecoder.signalIndex = freeSignalIndices.isEmpty()
+                    ? signalIndexCount++ : freeSignalIndices.takeLast();
+        }
+        decoder.signalIndexEnd = qMax(decoder.signalIndexEnd, signalDecoder.signalIndex + 1);
+    }
+}
+
+void QCanFrameProcessorPrivate::releaseSignalIndices(const QCanMessageDecoder &decoder)
+{
+    for (const QCanSignalDecoder &signalDecoder : decoder.signalDecoders)
+        releaseSignalIndex(signalDecoder.signalIndex);
+}
+
+void QCanFrameProcessorPrivate::releaseSignalIndex(qsizetype index)
+{
+    Q_ASSERT(index >= 0 && index < signalIndexCount);
+
+    // shrink the range instead of keeping free indices at its end
+    if (index == signalIndexCount - 1) {
+        --signalIndexCount;
+        while (!freeSignalIndices.isEmpty()
+               && freeSignalIndices.constFirst() == signalIndexCount - 1) {
+            freeSignalIndices.removeFirst();
+            --signalIndexCount;
+        }
+        return;
+    }
+
+    const auto position = std::lower_bound(freeSignalIndices.begin(), freeSignalIndices.end(),
+                                           index, std::greater<>());
+    freeSignalIndices.insert(position, index);
+}
+
+void QCanFrameProcessorPrivate::clearSignalIndices()
+{
+    signalIndexCount = 0;
+    freeSignalIndices.clear();
+}
+
 #ifdef USE_DBC_COMPATIBLE_BE_HANDLING
 
 template <typename T>
@@ -898,7 +1889,7 @@ static void encodeValue(unsigned char *data, const QVariant &valueVar,
     // Perform value conversion.
     T value = {};
     if (needValueConversion(signalDesc))
-        value = static_cast<T>(std::round(convertToCanValue(valueVar, signalDesc)));
+        value = static_cast<T>(std::round(convertToCanValue(valueVar.toDouble(), signalDesc)));
     else
         value = valueVar.value<T>();
 
@@ -998,7 +1989,7 @@ static void encodeValue(unsigned char *data, const QVariant &valueVar,
     // Perform value conversion.
     T value = {};
     if (needValueConversion(signalDesc))
-        value = static_cast<T>(std::round(convertToCanValue(valueVar, signalDesc)));
+        value = static_cast<T>(std::round(convertToCanValue(valueVar.toDouble(), signalDesc)));
     else
         value = valueVar.value<T>();
 
@@ -1081,8 +2072,146 @@ static void encodeAscii(unsigned char *data, const QVariant &value,
     }
 }
 
+// Returns the raw value of the signal, converted the same way as in
+// encodeValue().
+template <typename T, typename V>
+static T canValue(V value, const QCanSignalDecoder &decoder)
+{
+    if (decoder.convert)
+        return static_cast<T>(std::round(convertToCanValue(double(value), decoder.description)));
+    if constexpr (std::is_floating_point_v<V> && !std::is_floating_point_v<T>)
+        return T(qRound64(value)); // like QVariant does
+    else
+        return T(value);
+}
+
+// Returns the bits of \a value, as they are inserted into the word of the signal.
+template <typename V>
+static quint64 wordValue(V value, const QCanSignalDecoder &decoder)
+{
+    switch (decoder.format) {
+    case QtCanBus::DataFormat::SignedInteger:
+        return quint64(canValue<qint64>(value, decoder));
+    case QtCanBus::DataFormat::UnsignedInteger:
+        return canValue<quint64>(value, decoder);
+    case QtCanBus::DataFormat::Float: {
+        const float floatValue = canValue<float>(value, decoder);
+        quint32 bits;
+        memcpy(&bits, &floatValue, sizeof(bits));
+        return bits;
+    }
+    case QtCanBus::DataFormat::Double: {
+        const double doubleValue = canValue<double>(value, decoder);
+        quint64 bits;
+        memcpy(&bits, &doubleValue, sizeof(bits));
+        return bits;
+    }
+    case QtCanBus::DataFormat::AsciiString:
+        break; // never written from numbers
+    }
+    Q_UNREACHABLE_RETURN(0);
+}
+
+template <typename T>
+qsizetype QCanFrameProcessorPrivate::prepareFrameFrom(QtCanBus::UniqueId uniqueId,
+                                                      QSpan<const T> values, QCanBusFrame *frame,
+                                                      QCanFrameProcessorState &state) const
+{
+    using Error = QCanFrameProcessor::Error;
+
+    state.resetErrors();
+
+    if (!uidDescription.isValid()) {
+        state.setError(Error::Encoding,
+                       QObject::tr("No valid unique identifier description is specified."));
+        return -1;
+    }
+
+    const auto message = decoders.constFind(uniqueId);
+    if (message == decoders.cend()) {
+        state.setError(Error::Encoding,
+                       QObject::tr("Failed to find message description for unique id %1.").
+                       arg(qToUnderlying(uniqueId)));
+        return -1;
+    }
+
+    const qsizetype signalCount = message->signalDecoders.size();
+    if (qsizetype(values.size()) < message->signalIndexEnd) {
+        state.setError(Error::Encoding,
+                       QObject::tr("Not enough signal values for unique id %1. "
+                                   "Actual size = %2, expected size = %3.").
+                       arg(qToUnderlying(uniqueId)).arg(values.size()).
+                       arg(message->signalIndexEnd));
+        return -1;
+    }
+
+    // For data in FrameId we consider max length == 29, because we do not
+    // know if the frame is extended or not.
+    const qsizetype payloadSize = message->payloadSize;
+    const auto uidMaxLength = uidDecoder.fromPayload ? payloadSize * 8 : 29;
+    if (uidDecoder.maxBit >= uidMaxLength) {
+        state.setError(Error::Encoding,
+                       QObject::tr("Failed to encode unique id %1 into the frame").
+                       arg(qToUnderlying(uniqueId)));
+        return -1;
+    }
+
+    // Take over the payload of the frame, so that it can be modified without
+    // detaching. fill() only allocates if the payload is too small.
+    QByteArray payload = std::exchange(*frame, QCanBusFrame()).payload();
+    payload.fill(0x00, payloadSize);
+    QCanBusFrame::FrameId canFrameId = 0; // may be modified by the signal values
+    unsigned char *payloadData = reinterpret_cast<unsigned char *>(payload.data());
+    unsigned char *frameIdData = reinterpret_cast<unsigned char *>(&canFrameId);
+
+    fillUniqueId(uidDecoder.fromPayload ? payloadData : frameIdData, quint16(uidMaxLength),
+                 uniqueId);
+
+    qsizetype count = 0;
+    // The multiplexor values are kept as QVariant, to check the conditions
+    // of the multiplexed signals. These are numbers, which QVariant stores
+    // without allocating.
+    state.decodedValues.resize(signalCount);
+    for (qsizetype i = 0; i < signalCount; ++i) {
+        const QCanSignalDecoder &decoder = message->signalDecoders.at(i);
+        QVariant &muxValue = state.decodedValues[i];
+        muxValue = QVariant();
+        if (!muxConditionsMet(decoder, state))
+            continue;
+        if (!decoder.valid) {
+            state.addWarning(QObject::tr("Skipping signal %1. Its description is invalid.").
+                             arg(decoder.name));
+            continue;
+        }
+        if (decoder.format == QtCanBus::DataFormat::AsciiString)
+            continue;
+        const auto maxDataLength = decoder.fromPayload ? payloadSize * 8 : 29;
+        if (decoder.maxBit >= maxDataLength) {
+            state.addWarning(QObject::tr("Skipping signal %1. Its length exceeds the expected "
+                                         "message length.").arg(decoder.name));
+            continue;
+        }
+
+        const T value = values[decoder.signalIndex];
+        if (decoder.isMultiplexor)
+            muxValue = QVariant::fromValue(value);
+        unsigned char *data = decoder.fromPayload ? payloadData : frameIdData;
+        if (decoder.method == QCanSignalDecoder::Method::Generic) {
+            encodeSignal(data, QVariant::fromValue(value), decoder.description);
+        } else {
+            const qsizetype dataSize = decoder.fromPayload ? payloadSize
+                                                           : qsizetype(sizeof(canFrameId));
+            decoder.insertWord(data, dataSize, wordValue(value, decoder));
+        }
+        ++count;
+    }
+
+    *frame = QCanBusFrame(canFrameId, payload);
+    return count;
+}
+
 void QCanFrameProcessorPrivate::encodeSignal(unsigned char *data, const QVariant &value,
-                                             const QCanSignalDescription &signalDesc)
+                                             const QCanSignalDescription &signalDesc) const
 {
     // We assume that signal's length does not exceed data size.
     // That is checked as a precondition to calling this method, so we do not
@@ -1109,75 +2238,93 @@ void QCanFrameProcessorPrivate::encodeSignal(unsigned char *data, const QVariant
 std::optional<QtCanBus::UniqueId>
 QCanFrameProcessorPrivate::extractUniqueId(const QCanBusFrame &frame) const
 {
-    const auto signalDataEnd = extractMaxBitNum(uidDescription.startBit(),
-                                                uidDescription.bitLength(),
-                                                uidDescription.endian());
-    const bool dataFromPayload = uidDescription.source() == QtCanBus::DataSource::Payload;
+    using UnderlyingType = std::underlying_type_t<QtCanBus::UniqueId>;
+    if (uidFromFrameIdBits)
+        return QtCanBus::UniqueId{UnderlyingType((frame.frameId() >> uidDecoder.shift)
+                                                 & uidDecoder.mask)};
 
     // For the FrameId case we do not really care if the frame id is extended
     // or not, because QCanBusFrame::FrameId is anyway 32-bit unsigned.
-    const auto maxDataLength = dataFromPayload ? frame.payload().size() * 8 : 29;
+    const QByteArrayView payload = frame.payloadView();
+    const auto maxDataLength = uidDecoder.fromPayload ? payload.size() * 8 : 29;
 
-    if (signalDataEnd >= maxDataLength)
+    if (uidDecoder.maxBit >= maxDataLength)
         return {}; // add a more specific error description?
 
-    const QByteArray payload = frame.payload();
     const auto frameId = frame.frameId();
-    const unsigned char *data = dataFromPayload
+    const unsigned char *data = uidDecoder.fromPayload
             ? reinterpret_cast<const unsigned char *>(payload.data())
             : reinterpret_cast<const unsigned char *>(&frameId);
+    const qsizetype dataSize = uidDecoder.fromPayload ? payload.size() : qsizetype(sizeof(frameId));
 
-    // Now we need to do the same as when extracting a value for a signal, but
-    // without additional value conversions. We have an extractValue() template
-    // function, but it takes a QCanSignalDescription as an input parameter.
-    // To reuse the code, we generate a dummy QCanSignalDescription based on the
-    // values of uidDescription and call extractValue().
-    // This approach introduces some unneeded checks and also result conversions
-    // to/from QVariant. If this becomes a problem, we can copy-paste the code
-    // from extractValue() and remove the unneeded parts.
-
-    QCanSignalDescription dummyDesc;
-    dummyDesc.setDataSource(uidDescription.source());
-    dummyDesc.setDataEndian(uidDescription.endian());
-    dummyDesc.setStartBit(uidDescription.startBit());
-    dummyDesc.setBitLength(uidDescription.bitLength());
-    dummyDesc.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
-    // other fields are unused, so default-initialized
+    if (uidDecoder.method != QCanSignalDecoder::Method::Generic)
+        return QtCanBus::UniqueId{UnderlyingType(uidDecoder.extractWord(data, dataSize))};
 
-    using UnderlyingType = std::underlying_type_t<QtCanBus::UniqueId>;
-    const QVariant val = extractValue<UnderlyingType>(data, dummyDesc);
+    // The uidDecoder holds a dummy unsigned QCanSignalDescription based on
+    // the uidDescription, so extractValue() can be reused. This introduces
+    // some unneeded checks and conversions to/from QVariant, but only for
+    // the rare descriptions which do not fit into a 64-bit word.
+    const QVariant val = extractValue<UnderlyingType>(data, uidDecoder.description);
     return QtCanBus::UniqueId{val.value<UnderlyingType>()};
 }
 
 bool QCanFrameProcessorPrivate::fillUniqueId(unsigned char *data, quint16 sizeInBits,
-                                             QtCanBus::UniqueId uniqueId)
+                                             QtCanBus::UniqueId uniqueId) const
 {
-    const auto uidDataEnd = extractMaxBitNum(uidDescription.startBit(),
-                                             uidDescription.bitLength(),
-                                             uidDescription.endian());
-    if (uidDataEnd >= sizeInBits) {
+    if (uidDecoder.maxBit >= sizeInBits)
         return false; // add a more specific error description?
+
+    if (uidDecoder.method != QCanSignalDecoder::Method::Generic) {
+        uidDecoder.insertWord(data, (sizeInBits + 7) / 8, qToUnderlying(uniqueId));
+        return true;
     }
 
-    // Now we need to do the same as when encoding signal value into the frame,
-    // but without additional value conversions. We have encodeValue() template
-    // function, but it takes QCanSignalDescription as an input parameter.
-    // To reuse the code, we generate a dummy QCanSignalDescription based on the
-    // values of uidDescription, and call encodeValue().
-    // This approach introduces some unneeded checks and QVariant conversions.
-    // If this becomes a problem, we can copy-paste the code from encodeValue()
-    // and remove all the unneeded parts.
+    // Same as in extractUniqueId(), the dummy description of the uidDecoder
+    // is used for the rare descriptions which do not fit into a 64-bit word.
+    using UnderlyingType = std::underlying_type_t<QtCanBus::UniqueId>;
+    encodeValue<UnderlyingType>(data, QVariant::fromValue(qToUnderlying(uniqueId)),
+                                uidDecoder.description);
+    return true;
+}
 
-    QCanSignalDescription dummyDesc;
-    dummyDesc.setDataSource(uidDescription.source());
-    dummyDesc.setDataEndian(uidDescription.endian());
-    dummyDesc.setStartBit(uidDescription.startBit());
-    dummyDesc.setBitLength(uidDescription.bitLength());
-    dummyDesc.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
-    // other fields are unused, so default-initialized
+static bool isSameValue(double lhs, double rhs)
+{
+    return lhs == rhs || (qIsNaN(lhs) && qIsNaN(rhs));
+}
 
-    using UnderlyingType = std::underlying_type_t<QtCanBus::UniqueId>;
-    encodeValue<UnderlyingType>(data, QVariant::fromValue(qToUnderlying(uniqueId)), dummyDesc);
+bool QCanFrameProcessorPrivate::isSameSignal(const QCanSignalDescription &lhs,
+                                             const QCanSignalDescription &rhs)
+{
+    const auto *l = QCanSignalDescriptionPrivate::get(lhs);
+    const auto *r = QCanSignalDescriptionPrivate::get(rhs);
+    if (l == r)
+        return true;
+    return l->name == r->name && l->unit == r->unit && l->receiver == r->receiver
+            && l->comment == r->comment && l->source == r->source && l->endian == r->endian
+            && l->format == r->format && l->startBit == r->startBit
+            && l->dataLength == r->dataLength && isSameValue(l->factor, r->factor)
+            && isSameValue(l->offset, r->offset) && isSameValue(l->scaling, r->scaling)
+            && isSameValue(l->minimum, r->minimum) && isSameValue(l->maximum, r->maximum)
+            && l->muxState == r->muxState && l->muxSignals == r->muxSignals;
+}
+
+bool QCanFrameProcessorPrivate::isSameMessage(const QCanMessageDescription &lhs,
+                                              const QCanMessageDescription &rhs)
+{
+    const auto *l = QCanMessageDescriptionPrivate::get(lhs);
+    const auto *r = QCanMessageDescriptionPrivate::get(rhs);
+    if (l == r)
+        return true;
+    if (l->id != r->id || l->size != r->size || l->name != r->name
+            || l->transmitter != r->transmitter || l->comment != r->comment
+            || l->messageSignals.size() != r->messageSignals.size()) {
+        return false;
+    }
+    for (const auto &[name, signalDesc] : l->messageSignals.asKeyValueRange()) {
+        const auto other = r->messageSignals.constFind(name);
+        if (other == r->messageSignals.cend() || !isSameSignal(signalDesc, other.value()))
+            return false;
+    }
     return true;
 }
 
@@ -4,6 +4,9 @@
 #ifndef QCANFRAMEPROCESSOR_H
 #define QCANFRAMEPROCESSOR_H
 
+#include <QtCore/QByteArrayView>
+#include <QtCore/QSpan>
+#include <QtCore/QStringList>
 #include <QtCore/QVariantMap>
 
 #include <QtSerialBus/qcancommondefinitions.h>
@@ -34,12 +37,34 @@ public:
         QVariantMap signalValues;
     };
 
+    struct FrameResult {
+        QtCanBus::UniqueId uniqueId = QtCanBus::UniqueId{0};
+        QVariantMap signalValues;
+        Error error = Error::None;
+        QString errorString;
+        QStringList warnings;
+    };
+
     Q_SERIALBUS_EXPORT QCanFrameProcessor();
     Q_SERIALBUS_EXPORT ~QCanFrameProcessor();
 
     Q_SERIALBUS_EXPORT QCanBusFrame prepareFrame(QtCanBus::UniqueId uniqueId,
                                                  const QVariantMap &signalValues);
+    Q_SERIALBUS_EXPORT qsizetype prepareFrame(QtCanBus::UniqueId uniqueId,
+                                              QSpan<const double> values, QCanBusFrame *frame);
+    Q_SERIALBUS_EXPORT qsizetype prepareFrame(QtCanBus::UniqueId uniqueId,
+                                              QSpan<const qint64> values, QCanBusFrame *frame);
     Q_SERIALBUS_EXPORT ParseResult parseFrame(const QCanBusFrame &frame);
+    Q_SERIALBUS_EXPORT qsizetype parseFrame(const QCanBusFrame &frame, QSpan<double> values);
+    Q_SERIALBUS_EXPORT qsizetype parseFrame(const QCanBusFrame &frame, QSpan<qint64> values);
+    Q_SERIALBUS_EXPORT qsizetype parseColumn(QtCanBus::UniqueId uniqueId, qsizetype signalIndex,
+                                             QByteArrayView payloads, QSpan<double> values);
+    Q_SERIALBUS_EXPORT FrameResult decodeFrame(const QCanBusFrame &frame) const;
+    Q_SERIALBUS_EXPORT QList<FrameResult> decodeFrames(QSpan<const QCanBusFrame> frames) const;
+
+    Q_SERIALBUS_EXPORT qsizetype signalIndex(QtCanBus::UniqueId uniqueId,
+                                             const QString &signalName) const;
+    Q_SERIALBUS_EXPORT qsizetype signalIndexCount() const;
 
     Q_SERIALBUS_EXPORT Error error() const;
     Q_SERIALBUS_EXPORT QString errorString() const;
@@ -50,6 +75,8 @@ public:
     void addMessageDescriptions(const QList<QCanMessageDescription> &descriptions);
     Q_SERIALBUS_EXPORT
     void setMessageDescriptions(const QList<QCanMessageDescription> &descriptions);
+    Q_SERIALBUS_EXPORT
+    qsizetype updateMessageDescriptions(const QList<QCanMessageDescription> &descriptions);
     Q_SERIALBUS_EXPORT void clearMessageDescriptions();
 
     Q_SERIALBUS_EXPORT QCanUniqueIdDescription uniqueIdDescription() const;
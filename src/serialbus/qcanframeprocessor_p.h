@@ -18,35 +18,164 @@
 #include "qtserialbusexports.h"
 #include "qcanframeprocessor.h"
 #include "qcanmessagedescription.h"
+#include "qcansignaldescription.h"
 #include "qcanuniqueiddescription.h"
 
 #include <QtCore/QHash>
 #include <QtCore/QSharedData>
+#include <QtCore/QtEndian>
+
+#include <cstring>
 
 #include <utility>
 
 QT_BEGIN_NAMESPACE
 
-class QCanFrameProcessorPrivate
+// Precompiled extraction and insertion of a single signal. Signals which fit
+// into a 64-bit word are extracted and inserted with one load, shift and mask,
+// all other signals fall back to the bitwise processing in
+// QCanFrameProcessorPrivate::parseData() and encodeSignal().
+struct QCanSignalDecoder
+{
+    enum class Method : quint8 {
+        LittleEndianWord,
+        BigEndianWord,
+        Generic,
+    };
+
+    QCanSignalDescription description;
+    QString name;
+    // index of the multiplexor signal in QCanMessageDecoder::signalDecoders,
+    // and the values it must have for this signal to be decoded
+    QList<std::pair<qsizetype, QCanSignalDescription::MultiplexValues>> muxConditions;
+    quint64 mask = 0;
+    quint16 byteOffset = 0;
+    quint16 maxBit = 0;
+    quint8 shift = 0;
+    Method method = Method::Generic;
+    QtCanBus::DataFormat format = QtCanBus::DataFormat::SignedInteger;
+    qsizetype signalIndex = -1; // see QCanFrameProcessor::signalIndex()
+    bool fromPayload = true;
+    bool valid = false;
+    bool convert = false;
+    bool isMultiplexor = false; // other signals of the message depend on its value
+
+    quint64 loadWord(const unsigned char *data, qsizetype size) const noexcept
+    {
+        // the signal was checked to end within size, but the word may reach beyond
+        unsigned char word[8] = {};
+        std::memcpy(word, data + byteOffset, size_t(qMin<qsizetype>(8, size - byteOffset)));
+        return method == Method::LittleEndianWord ? qFromLittleEndian<quint64>(word)
+                                                  : qFromBigEndian<quint64>(word);
+    }
+
+    quint64 extractWord(const unsigned char *data, qsizetype size) const noexcept
+    {
+        return (loadWord(data, size) >> shift) & mask;
+    }
+
+    void insertWord(unsigned char *data, qsizetype size, quint64 value) const noexcept
+    {
+        // same as in extractWord(), only the bytes within size are written back
+        unsigned char word[8] = {};
+        const size_t count = size_t(qMin<qsizetype>(8, size - byteOffset));
+        std::memcpy(word, data + byteOffset, count);
+        const bool littleEndian = method == Method::LittleEndianWord;
+        quint64 current = littleEndian ? qFromLittleEndian<quint64>(word)
+                                       : qFromBigEndian<quint64>(word);
+        current = (current & ~(mask << shift)) | ((value & mask) << shift);
+        if (littleEndian)
+            qToLittleEndian(current, word);
+        else
+            qToBigEndian(current, word);
+        std::memcpy(data + byteOffset, word, count);
+    }
+};
+
+// The signal decoders of a message, ordered so that each multiplexor signal
+// is decoded before the signals which depend on it. The signal indices are
+// not ordered; all of them are smaller than signalIndexEnd.
+struct QCanMessageDecoder
+{
+    QList<QCanSignalDecoder> signalDecoders;
+    qsizetype payloadSize = 0;
+    qsizetype signalIndexEnd = 0;
+};
+
+// The errors, warnings and scratch space of the decoding. The decoding
+// functions of QCanFrameProcessorPrivate are const and modify only this
+// state, so that multiple threads can decode frames with the same processor,
+// each with its own state.
+struct QCanFrameProcessorState
 {
-public:
     void resetErrors();
     void setError(QCanFrameProcessor::Error err, const QString &desc);
     void addWarning(const QString &warning);
-    QVariant decodeSignal(const QCanBusFrame &frame, const QCanSignalDescription &signalDesc);
-    QVariant parseData(const unsigned char *data, const QCanSignalDescription &signalDesc);
+
+    QCanFrameProcessor::Error error = QCanFrameProcessor::Error::None;
+    QString errorString;
+    QStringList warnings;
+    QList<QVariant> decodedValues; // values of the signals, indexed like the decoders
+};
+
+class QCanFrameProcessorPrivate
+{
+public:
+    const QCanMessageDecoder *findDecoder(const QCanBusFrame &frame,
+                                          QtCanBus::UniqueId *uniqueId,
+                                          QCanFrameProcessorState &state) const;
+    QCanFrameProcessor::ParseResult parseFrame(const QCanBusFrame &frame,
+                                               QCanFrameProcessorState &state) const;
+    QCanFrameProcessor::FrameResult decodeFrame(const QCanBusFrame &frame,
+                                                QCanFrameProcessorState &state) const;
+    template <typename T>
+    qsizetype parseFrameInto(const QCanBusFrame &frame, QSpan<T> values,
+                             QCanFrameProcessorState &state) const;
+    qsizetype parseColumn(QtCanBus::UniqueId uniqueId, qsizetype signalIndex,
+                          QByteArrayView payloads, QSpan<double> values,
+                          QCanFrameProcessorState &state) const;
+    bool signalFits(const QCanBusFrame &frame, const QCanSignalDecoder &decoder,
+                    QCanFrameProcessorState &state) const;
+    QVariant decodeSignal(const QCanBusFrame &frame, const QCanSignalDecoder &decoder,
+                          QCanFrameProcessorState &state) const;
+    bool muxConditionsMet(const QCanSignalDecoder &decoder,
+                          const QCanFrameProcessorState &state) const;
+    QVariant decodeValue(const QCanSignalDecoder &decoder, const unsigned char *data,
+                         qsizetype size) const;
+    template <typename T>
+    T decodeNumber(const QCanSignalDecoder &decoder, const unsigned char *data,
+                   qsizetype size) const;
+    QVariant parseData(const unsigned char *data, const QCanSignalDescription &signalDesc) const;
+    template <typename T>
+    qsizetype prepareFrameFrom(QtCanBus::UniqueId uniqueId, QSpan<const T> values,
+                               QCanBusFrame *frame, QCanFrameProcessorState &state) const;
     void encodeSignal(unsigned char *data, const QVariant &value,
-                      const QCanSignalDescription &signalDesc);
+                      const QCanSignalDescription &signalDesc) const;
     std::optional<QtCanBus::UniqueId> extractUniqueId(const QCanBusFrame &frame) const;
-    bool fillUniqueId(unsigned char *data, quint16 sizeInBits, QtCanBus::UniqueId uniqueId);
+    bool fillUniqueId(unsigned char *data, quint16 sizeInBits,
+                      QtCanBus::UniqueId uniqueId) const;
+
+    static QCanSignalDecoder createSignalDecoder(const QCanSignalDescription &signalDesc);
+    static QCanMessageDecoder createMessageDecoder(const QCanMessageDescription &message);
+    static bool isSameSignal(const QCanSignalDescription &lhs, const QCanSignalDescription &rhs);
+    static bool isSameMessage(const QCanMessageDescription &lhs,
+                              const QCanMessageDescription &rhs);
+
+    void assignSignalIndices(QCanMessageDecoder &decoder, const QCanMessageDecoder *previous);
+    void releaseSignalIndices(const QCanMessageDecoder &decoder);
+    void releaseSignalIndex(qsizetype index);
+    void clearSignalIndices();
 
     static QCanFrameProcessorPrivate *get(const QCanFrameProcessor &processor);
 
-    QCanFrameProcessor::Error error = QCanFrameProcessor::Error::None;
-    QString errorString;
-    QStringList warnings;
+    QCanFrameProcessorState state; // of the non-const parseFrame() and prepareFrame()
     QHash<QtCanBus::UniqueId, QCanMessageDescription> messages;
+    QHash<QtCanBus::UniqueId, QCanMessageDecoder> decoders;
+    qsizetype signalIndexCount = 0;
+    QList<qsizetype> freeSignalIndices; // below signalIndexCount, sorted in descending order
     QCanUniqueIdDescription uidDescription;
+    QCanSignalDecoder uidDecoder;
+    bool uidFromFrameIdBits = false; // see extractUniqueId()
 };
 
 QT_END_NAMESPACE
@@ -5,6 +5,7 @@
 #define QMODBUSADU_P_H
 
 #include <QtSerialBus/qmodbuspdu.h>
+#include <QtCore/qendian.h>
 #include <QtCore/private/qglobal_p.h>
 
 //
@@ -20,6 +21,27 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QtModbusPrivate {
+
+// Lookup table for the reflected Modbus CRC-16 (polynomial 0x8005, reflected 0xA001).
+struct CrcLookupTable
+{
+    constexpr CrcLookupTable()
+    {
+        for (quint16 i = 0; i < 256; ++i) {
+            quint16 crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? quint16((crc >> 1) ^ 0xA001) : quint16(crc >> 1);
+            values[i] = crc;
+        }
+    }
+    quint16 values[256] = {};
+};
+
+inline constexpr CrcLookupTable crcTable;
+
+} // namespace QtModbusPrivate
+
 class QModbusSerialAdu
 {
 public:
@@ -91,30 +113,16 @@ public:
 
         Returns the CRC checksum of the first \a len bytes of \a data.
 
-        \note The code used by the function was generated with pycrc. There is no copyright assigned
-        to the generated code, however, the author of the script requests to show the line stating
-        that the code was generated by pycrc (see implementation).
+        The checksum is the reflected CRC-16 with the polynomial 0x8005 and the initial value
+        0xFFFF, as required by Modbus RTU. It is computed one byte at a time using a lookup table
+        that is generated at compile time. The two bytes of the result are swapped, so that
+        streaming the value into a QDataStream places the low-order byte first on the wire.
     */
     inline static quint16 calculateCRC(const char *data, qint32 len)
     {
-        // Generated by pycrc v0.8.3, https://pycrc.org
-        // Width = 16, Poly = 0x8005, XorIn = 0xffff, ReflectIn = True,
-        // XorOut = 0x0000, ReflectOut = True, Algorithm = bit-by-bit-fast
-
         quint16 crc = 0xFFFF;
-        while (len--) {
-            const quint8 c = *data++;
-            for (qint32 i = 0x01; i & 0xFF; i <<= 1) {
-                bool bit = crc & 0x8000;
-                if (c & i)
-                    bit = !bit;
-                crc <<= 1;
-                if (bit)
-                    crc ^= 0x8005;
-            }
-            crc &= 0xFFFF;
-        }
-        crc = crc_reflect(crc & 0xFFFF, 16) ^ 0x0000;
+        while (len--)
+            crc = (crc >> 8) ^ QtModbusPrivate::crcTable.values[(crc ^ quint8(*data++)) & 0xFF];
         return (crc >> 8) | (crc << 8); // swap bytes
     }
 
@@ -134,24 +142,186 @@ public:
     }
 
 private:
-    inline static quint16 crc_reflect(quint16 data, qint32 len)
+    Type m_type = Rtu;
+    QByteArray m_data;
+    QByteArray m_rawData;
+};
+
+class QModbusTcpAdu
+{
+public:
+    static constexpr qsizetype HeaderSize = 7;
+
+    struct Header
     {
-        // Generated by pycrc v0.8.3, https://pycrc.org
-        // Width = 16, Poly = 0x8005, XorIn = 0xffff, ReflectIn = True,
-        // XorOut = 0x0000, ReflectOut = True, Algorithm = bit-by-bit-fast
-
-        quint16 ret = data & 0x01;
-        for (qint32 i = 1; i < len; i++) {
-            data >>= 1;
-            ret = (ret << 1) | (data & 0x01);
+        quint16 transactionId = 0;
+        quint16 protocolId = 0;
+        quint16 length = 0; // byte count of the unit identifier and the PDU
+        quint8 unitId = 0;
+    };
+
+    /*!
+        \internal
+
+        Decodes the MBAP header from the first \l HeaderSize bytes of \a data.
+    */
+    static Header readHeader(const char *data)
+    {
+        return { qFromBigEndian<quint16>(data), qFromBigEndian<quint16>(data + 2),
+                 qFromBigEndian<quint16>(data + 4), quint8(data[6]) };
+    }
+
+    /*!
+        \internal
+
+        Encodes \a header into the first \l HeaderSize bytes of \a data.
+    */
+    static void writeHeader(const Header &header, char *data)
+    {
+        qToBigEndian<quint16>(header.transactionId, data);
+        qToBigEndian<quint16>(header.protocolId, data + 2);
+        qToBigEndian<quint16>(header.length, data + 4);
+        data[6] = char(header.unitId);
+    }
+
+    /*!
+        \internal
+
+        Returns the PDU stored in the \a size bytes at \a pos of \a buffer. The length is
+        taken from the MBAP header, not from the function code. If the PDU is the last one
+        in \a buffer, its data shares the storage of \a buffer instead of being copied; the
+        buffer's terminating null byte then also terminates the PDU data.
+    */
+    template <typename Pdu>
+    static Pdu pduFromBuffer(QByteArray &buffer, qsizetype pos, qsizetype size)
+    {
+        Q_ASSERT(size > 0 && pos + size <= buffer.size());
+        const auto code = QModbusPdu::FunctionCode(quint8(buffer.at(pos)));
+        const qsizetype dataPos = pos + 1;
+        const qsizetype dataSize = size - 1;
+        if (dataSize == 0)
+            return Pdu(code, QByteArray());
+
+        QByteArray::DataPointer &bufferData = buffer.data_ptr();
+        if (dataPos + dataSize != buffer.size() || !bufferData.d_ptr())
+            return Pdu(code, QByteArray(buffer.constData() + dataPos, dataSize));
+
+        bufferData.d_ptr()->ref();
+        return Pdu(code, QByteArray(QByteArray::DataPointer(bufferData.d_ptr(),
+                                                            bufferData.data() + dataPos,
+                                                            dataSize)));
+    }
+
+    /*!
+        \internal
+
+        Appends the TCP ADU for \a pdu to \a out. The length field of \a header is ignored
+        and computed from the size of \a pdu.
+    */
+    static void appendTo(QByteArray &out, Header header, const QModbusPdu &pdu)
+    {
+        // The length field is the byte count of the following fields, including the Unit
+        // Identifier and PDU fields, so we add one byte to the PDU size.
+        header.length = quint16(pdu.size() + 1);
+
+        const qsizetype pos = out.size();
+        out.resize(pos + HeaderSize + pdu.size());
+        char *adu = out.data() + pos;
+        writeHeader(header, adu);
+        adu[HeaderSize] = char(pdu.isException() ? pdu.functionCode() | QModbusPdu::ExceptionByte
+                                                 : pdu.functionCode());
+        const QByteArray data = pdu.data();
+        if (!data.isEmpty())
+            memcpy(adu + HeaderSize + 1, data.constData(), data.size());
+    }
+
+    /*!
+        \internal
+
+        Returns the TCP ADU for \a pdu. See appendTo().
+    */
+    static QByteArray create(const Header &header, const QModbusPdu &pdu)
+    {
+        QByteArray result;
+        result.reserve(HeaderSize + pdu.size());
+        appendTo(result, header, pdu);
+        return result;
+    }
+};
+
+class QModbusReceiveBuffer
+{
+public:
+    /*!
+        \internal
+
+        Appends \a data to the unread bytes. Bytes consumed before are only moved out of the
+        way once they make up at least half of the buffer, which keeps the cost of consuming
+        many small frames from a large burst linear in the size of the burst.
+    */
+    void append(const QByteArray &data)
+    {
+        if (m_offset > 0 && m_offset >= m_buffer.size() / 2) {
+            m_buffer.remove(0, m_offset);
+            m_offset = 0;
         }
-        return ret;
+        m_buffer.append(data);
+    }
+
+    /*!
+        \internal
+
+        Marks the first \a count unread bytes as read. Once everything has been read, the
+        storage is released, so that the next append() can adopt the new data without copying.
+    */
+    void consume(qsizetype count)
+    {
+        Q_ASSERT(count >= 0 && count <= size());
+        m_offset += count;
+        if (m_offset == m_buffer.size())
+            clear();
+    }
+
+    void clear()
+    {
+        m_buffer.clear();
+        m_offset = 0;
+    }
+
+    qsizetype size() const { return m_buffer.size() - m_offset; }
+    bool isEmpty() const { return size() == 0; }
+    const char *constData() const { return m_buffer.constData() + m_offset; }
+
+    /*!
+        \internal
+
+        Returns a copy of the first \a count unread bytes.
+    */
+    QByteArray left(qsizetype count) const { return QByteArray(constData(), count); }
+
+    /*!
+        \internal
+
+        Returns the unread bytes without copying them. The returned byte array refers to the
+        storage of the buffer and must not be used after the buffer has been modified.
+    */
+    QByteArray rawData() const { return QByteArray::fromRawData(constData(), size()); }
+
+    /*!
+        \internal
+
+        Returns the PDU stored in the \a count bytes at \a pos of the unread bytes. See
+        QModbusTcpAdu::pduFromBuffer().
+    */
+    template <typename Pdu>
+    Pdu pdu(qsizetype pos, qsizetype count)
+    {
+        return QModbusTcpAdu::pduFromBuffer<Pdu>(m_buffer, m_offset + pos, count);
     }
 
 private:
-    Type m_type = Rtu;
-    QByteArray m_data;
-    QByteArray m_rawData;
+    QByteArray m_buffer;
+    qsizetype m_offset = 0;
 };
 
 QT_END_NAMESPACE
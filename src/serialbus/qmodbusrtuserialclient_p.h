@@ -75,15 +75,16 @@ class QModbusRtuSerialClientPrivate : public QModbusClientPrivate
 public:
     void onReadyRead()
     {
-        m_responseBuffer += m_serialPort->read(m_serialPort->bytesAvailable());
-        qCDebug(QT_MODBUS_LOW) << "(RTU client) Response buffer:" << m_responseBuffer.toHex();
+        m_responseBuffer.append(m_serialPort->read(m_serialPort->bytesAvailable()));
+        qCDebug(QT_MODBUS_LOW) << "(RTU client) Response buffer:"
+                               << m_responseBuffer.rawData().toHex();
 
         if (m_responseBuffer.size() < 2) {
             qCDebug(QT_MODBUS) << "(RTU client) Modbus ADU not complete";
             return;
         }
 
-        const QModbusSerialAdu tmpAdu(QModbusSerialAdu::Rtu, m_responseBuffer);
+        const QModbusSerialAdu tmpAdu(QModbusSerialAdu::Rtu, m_responseBuffer.rawData());
         int pduSizeWithoutFcode = QModbusResponse::calculateDataSize(tmpAdu.pdu());
         if (pduSizeWithoutFcode < 0) {
             // wait for more data
@@ -121,11 +122,12 @@ public:
         }
 
         const QModbusSerialAdu adu(QModbusSerialAdu::Rtu, m_responseBuffer.left(aduSize));
-        m_responseBuffer.remove(0, aduSize);
+        m_responseBuffer.consume(aduSize);
 
         qCDebug(QT_MODBUS) << "(RTU client) Received ADU:" << adu.rawData().toHex();
         if (QT_MODBUS().isDebugEnabled() && !m_responseBuffer.isEmpty())
-            qCDebug(QT_MODBUS_LOW) << "(RTU client) Pending buffer:" << m_responseBuffer.toHex();
+            qCDebug(QT_MODBUS_LOW) << "(RTU client) Pending buffer:"
+                                   << m_responseBuffer.rawData().toHex();
 
         // check CRC
         if (!adu.matchingChecksum()) {
@@ -376,7 +378,7 @@ public:
     QIODevice *device() const override { return m_serialPort; }
 
     Timer m_responseTimer;
-    QByteArray m_responseBuffer;
+    QModbusReceiveBuffer m_responseBuffer;
 
     QQueue<QueueElement> m_queue;
     QSerialPort *m_serialPort = nullptr;
@@ -4,11 +4,14 @@
 #ifndef QMODBUSTCPCLIENT_P_H
 #define QMODBUSTCPCLIENT_P_H
 
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qqueue.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qtcpsocket.h>
 #include "QtSerialBus/qmodbustcpclient.h"
 
+#include "private/qmodbusadu_p.h"
 #include "private/qmodbusclient_p.h"
 
 //
@@ -38,6 +41,12 @@ public:
 
         m_socket = new QTcpSocket(q);
 
+        m_clock.start();
+        m_timeoutTimer = new QTimer(q);
+        m_timeoutTimer->setSingleShot(true);
+        QObject::connect(m_timeoutTimer, &QTimer::timeout, q, [this]() { processTimeouts(); });
+        QObject::connect(q, &QModbusClient::timeoutChanged, q, [this]() { restartTimeouts(); });
+
         QObject::connect(m_socket, &QAbstractSocket::connected, q, [this]() {
             qCDebug(QT_MODBUS) << "(TCP client) Connected to" << m_socket->peerAddress()
                                << "on port" << m_socket->peerPort();
@@ -67,8 +76,9 @@ public:
         });
 
         QObject::connect(m_socket, &QIODevice::readyRead, q, [this](){
-            responseBuffer += m_socket->read(m_socket->bytesAvailable());
-            qCDebug(QT_MODBUS_LOW) << "(TCP client) Response buffer:" << responseBuffer.toHex();
+            responseBuffer.append(m_socket->read(m_socket->bytesAvailable()));
+            qCDebug(QT_MODBUS_LOW) << "(TCP client) Response buffer:"
+                                   << responseBuffer.rawData().toHex();
 
             while (!responseBuffer.isEmpty()) {
                 // can we read enough for Modbus ADU header?
@@ -77,119 +87,229 @@ public:
                     return;
                 }
 
-                quint8 serverAddress;
-                quint16 transactionId, bytesPdu, protocolId;
-                QDataStream input(responseBuffer);
-                input >> transactionId >> protocolId >> bytesPdu >> serverAddress;
+                const QModbusTcpAdu::Header header
+                    = QModbusTcpAdu::readHeader(responseBuffer.constData());
+                const quint16 transactionId = header.transactionId;
 
                 // stop the timer as soon as we know enough about the transaction
-                const bool knownTransaction = m_transactionStore.contains(transactionId);
-                if (knownTransaction && m_transactionStore[transactionId].timer)
-                    m_transactionStore[transactionId].timer->stop();
+                if (Transaction *transaction = findTransaction(transactionId))
+                    transaction->deadline = -1;
 
                 qCDebug(QT_MODBUS) << "(TCP client) tid:" << Qt::hex << transactionId << "size:"
-                    << bytesPdu << "server address:" << serverAddress;
+                    << header.length << "server address:" << header.unitId;
 
                 // The length field is the byte count of the following fields, including the Unit
                 // Identifier and the PDU, so we remove on byte.
-                bytesPdu--;
+                const qsizetype bytesPdu = qMax(qsizetype(header.length) - 1, qsizetype(0));
 
-                int tcpAduSize = mbpaHeaderSize + bytesPdu;
+                const qsizetype tcpAduSize = mbpaHeaderSize + bytesPdu;
                 if (responseBuffer.size() < tcpAduSize) {
                     qCDebug(QT_MODBUS) << "(TCP client) PDU too short. Waiting for more data";
                     return;
                 }
 
-                QModbusResponse responsePdu;
-                input >> responsePdu;
+                const QModbusResponse responsePdu = bytesPdu > 0
+                    ? responseBuffer.pdu<QModbusResponse>(mbpaHeaderSize, bytesPdu)
+                    : QModbusResponse();
                 qCDebug(QT_MODBUS) << "(TCP client) Received PDU:" << responsePdu.functionCode()
                                    << responsePdu.data().toHex();
 
-                responseBuffer.remove(0, tcpAduSize);
+                responseBuffer.consume(tcpAduSize);
 
-                if (!knownTransaction) {
+                QueueElement element;
+                if (!takeTransaction(transactionId, &element)) {
                     qCDebug(QT_MODBUS) << "(TCP client) No pending request for response with "
                         "given transaction ID, ignoring response message.";
                 } else {
-                    processQueueElement(responsePdu, m_transactionStore[transactionId]);
+                    processQueueElement(responsePdu, element);
                 }
             }
         });
     }
 
+    bool writeToSocket(quint16 tId, const QModbusRequest &request, int address)
+    {
+        QModbusTcpAdu::Header header;
+        header.transactionId = tId;
+        header.unitId = quint8(address);
+        const QByteArray buffer = QModbusTcpAdu::create(header, request);
+
+        int writtenBytes = m_socket->write(buffer);
+        if (writtenBytes == -1 || writtenBytes < buffer.size()) {
+            Q_Q(QModbusTcpClient);
+            qCDebug(QT_MODBUS) << "(TCP client) Cannot write request to socket.";
+            q->setError(QModbusTcpClient::tr("Could not write request to socket."),
+                        QModbusDevice::WriteError);
+            return false;
+        }
+        qCDebug(QT_MODBUS_LOW) << "(TCP client) Sent TCP ADU:" << buffer.toHex();
+        qCDebug(QT_MODBUS) << "(TCP client) Sent TCP PDU:" << request << "with tId:" <<Qt:: hex
+            << tId;
+        return true;
+    }
+
     QModbusReply *enqueueRequest(const QModbusRequest &request, int serverAddress,
                                  const QModbusDataUnit &unit,
                                  QModbusReply::ReplyType type) override
     {
-        auto writeToSocket = [this](quint16 tId, const QModbusRequest &request, int address) {
-            QByteArray buffer;
-            QDataStream output(&buffer, QIODevice::WriteOnly);
-            output << tId << quint16(0) << quint16(request.size() + 1) << quint8(address) << request;
-
-            int writtenBytes = m_socket->write(buffer);
-            if (writtenBytes == -1 || writtenBytes < buffer.size()) {
-                Q_Q(QModbusTcpClient);
-                qCDebug(QT_MODBUS) << "(TCP client) Cannot write request to socket.";
-                q->setError(QModbusTcpClient::tr("Could not write request to socket."),
-                            QModbusDevice::WriteError);
-                return false;
-            }
-            qCDebug(QT_MODBUS_LOW) << "(TCP client) Sent TCP ADU:" << buffer.toHex();
-            qCDebug(QT_MODBUS) << "(TCP client) Sent TCP PDU:" << request << "with tId:" <<Qt:: hex
-                << tId;
-            return true;
-        };
-
-        const int tId = transactionId();
+        const quint16 tId = transactionId();
         if (!writeToSocket(tId, request, serverAddress))
             return nullptr;
 
         Q_Q(QModbusTcpClient);
         auto reply = new QModbusReply(type, serverAddress, q);
-        const auto element = QueueElement{ reply, request, unit, m_numberOfRetries,
-            m_responseTimeoutDuration };
-        m_transactionStore.insert(tId, element);
+        armTimeout(insertTransaction(tId, QueueElement{ reply, request, unit,
+                                                        m_numberOfRetries }));
+        incrementTransactionId();
 
-        q->connect(reply, &QObject::destroyed, q, [this, tId](QObject *) {
-            if (!m_transactionStore.contains(tId))
-                return;
-            const QueueElement element = m_transactionStore.take(tId);
-            if (element.timer)
-                element.timer->stop();
-        });
+        return reply;
+    }
 
-        if (element.timer) {
-            q->connect(q, &QModbusClient::timeoutChanged,
-                       element.timer.data(), QOverload<int>::of(&QTimer::setInterval));
-            QObject::connect(element.timer.data(), &QTimer::timeout, q, [this, writeToSocket, tId]() {
-                if (!m_transactionStore.contains(tId))
-                    return;
+    /*
+        Outstanding transactions live in a table indexed by the low bits of their transaction
+        id. The ids are handed out sequentially, so the table only grows beyond the number of
+        requests in flight if a single transaction stays unanswered for a long time. At 65536
+        slots every id has a slot of its own.
+    */
+    struct Transaction
+    {
+        QueueElement element;
+        qint64 deadline = -1; // in m_clock time, -1 while no response timeout is pending
+        quint16 id = 0;
+        bool active = false;
+    };
 
-                QueueElement elem = m_transactionStore.take(tId);
-                if (elem.reply.isNull())
-                    return;
+    Transaction *findTransaction(quint16 tId)
+    {
+        if (m_transactions.isEmpty())
+            return nullptr;
+        Transaction &transaction = m_transactions[tId & (m_transactions.size() - 1)];
+        return (transaction.active && transaction.id == tId) ? &transaction : nullptr;
+    }
 
-                if (elem.numberOfRetries > 0) {
-                    elem.numberOfRetries--;
-                    if (!writeToSocket(tId, elem.requestPdu, elem.reply->serverAddress()))
-                        return;
-                    m_transactionStore.insert(tId, elem);
-                    elem.timer->start();
-                    qCDebug(QT_MODBUS) << "(TCP client) Resend request with tId:" << Qt::hex << tId;
-                } else {
-                    qCDebug(QT_MODBUS) << "(TCP client) Timeout of request with tId:" <<Qt::hex << tId;
-                    elem.reply->setError(QModbusDevice::TimeoutError,
-                        QModbusClient::tr("Request timeout."));
-                }
-            });
-            element.timer->start();
+    Transaction &insertTransaction(quint16 tId, QueueElement &&element)
+    {
+        if (m_transactions.isEmpty())
+            m_transactions.resize(MinimumTransactionSlots);
+
+        while (m_transactions.size() < MaximumTransactionSlots) {
+            const Transaction &slot = m_transactions.at(tId & (m_transactions.size() - 1));
+            if (!slot.active || slot.id == tId)
+                break;
+
+            QList<Transaction> transactions(m_transactions.size() * 2);
+            const qsizetype mask = transactions.size() - 1;
+            for (Transaction &transaction : m_transactions) {
+                if (transaction.active)
+                    transactions[transaction.id & mask] = std::move(transaction);
+            }
+            m_transactions = std::move(transactions);
+        }
+
+        // As with any other map, a transaction using the same id is replaced.
+        Transaction &transaction = m_transactions[tId & (m_transactions.size() - 1)];
+        if (!transaction.active)
+            ++m_transactionCount;
+        transaction.element = std::move(element);
+        transaction.deadline = -1;
+        transaction.id = tId;
+        transaction.active = true;
+        return transaction;
+    }
+
+    bool takeTransaction(quint16 tId, QueueElement *element)
+    {
+        Transaction *transaction = findTransaction(tId);
+        if (!transaction)
+            return false;
+
+        *element = std::exchange(transaction->element, QueueElement());
+        transaction->deadline = -1;
+        transaction->active = false;
+        --m_transactionCount;
+        return true;
+    }
+
+    /*
+        All response timeouts have the same duration, so the deadlines are queued in the order
+        they expire and a single timer waits for the earliest one. Deadlines of transactions
+        that have been answered or rearmed since are skipped when they come up.
+    */
+    struct Deadline
+    {
+        qint64 time;
+        quint16 transactionId;
+    };
+
+    void armTimeout(Transaction &transaction)
+    {
+        transaction.deadline = m_clock.elapsed() + m_responseTimeoutDuration;
+        m_deadlines.enqueue({ transaction.deadline, transaction.id });
+        if (!m_timeoutTimer->isActive())
+            m_timeoutTimer->start(m_responseTimeoutDuration);
+    }
+
+    bool isPending(const Deadline &deadline)
+    {
+        const Transaction *transaction = findTransaction(deadline.transactionId);
+        return transaction && transaction->deadline == deadline.time;
+    }
+
+    void scheduleNextTimeout()
+    {
+        while (!m_deadlines.isEmpty() && !isPending(m_deadlines.head()))
+            m_deadlines.dequeue();
+
+        if (m_deadlines.isEmpty()) {
+            m_timeoutTimer->stop();
+            return;
+        }
+        const qint64 remaining = m_deadlines.head().time - m_clock.elapsed();
+        m_timeoutTimer->start(int(qMax(remaining, qint64(0))));
+    }
+
+    void processTimeouts()
+    {
+        const qint64 now = m_clock.elapsed();
+        while (!m_deadlines.isEmpty() && m_deadlines.head().time <= now) {
+            const Deadline deadline = m_deadlines.dequeue();
+            if (isPending(deadline))
+                processTimeout(deadline.transactionId);
+        }
+        scheduleNextTimeout();
+    }
+
+    void processTimeout(quint16 tId)
+    {
+        QueueElement elem;
+        if (!takeTransaction(tId, &elem) || elem.reply.isNull())
+            return;
+
+        if (elem.numberOfRetries > 0) {
+            elem.numberOfRetries--;
+            if (!writeToSocket(tId, elem.requestPdu, elem.reply->serverAddress()))
+                return;
+            armTimeout(insertTransaction(tId, std::move(elem)));
+            qCDebug(QT_MODBUS) << "(TCP client) Resend request with tId:" << Qt::hex << tId;
         } else {
-            qCWarning(QT_MODBUS) << "(TCP client) No response timeout timer for request with tId:"
-                << Qt::hex << tId << ". Expected timeout:" << m_responseTimeoutDuration;
+            qCDebug(QT_MODBUS) << "(TCP client) Timeout of request with tId:" <<Qt::hex << tId;
+            elem.reply->setError(QModbusDevice::TimeoutError,
+                QModbusClient::tr("Request timeout."));
         }
-        incrementTransactionId();
+    }
 
-        return reply;
+    // A changed timeout restarts all pending response timeouts with the new duration.
+    void restartTimeouts()
+    {
+        m_deadlines.clear();
+        const qint64 deadline = m_clock.elapsed() + m_responseTimeoutDuration;
+        for (Transaction &transaction : m_transactions) {
+            if (transaction.active && transaction.deadline >= 0) {
+                transaction.deadline = deadline;
+                m_deadlines.enqueue({ deadline, transaction.id });
+            }
+        }
+        scheduleNextTimeout();
     }
 
     // TODO: Review once we have a transport layer in place.
@@ -202,18 +322,23 @@ public:
 
     void cleanupTransactionStore()
     {
-        if (m_transactionStore.isEmpty())
+        if (m_transactionCount == 0)
             return;
 
         qCDebug(QT_MODBUS) << "(TCP client) Cleanup of pending requests";
 
-        for (const auto &elem : std::as_const(m_transactionStore)) {
-            if (elem.reply.isNull())
+        const QList<Transaction> transactions = std::exchange(m_transactions, {});
+        m_transactionCount = 0;
+        m_deadlines.clear();
+        m_timeoutTimer->stop();
+
+        for (const Transaction &transaction : transactions) {
+            const QueueElement &elem = transaction.element;
+            if (!transaction.active || elem.reply.isNull())
                 continue;
             elem.reply->setError(QModbusDevice::ReplyAbortedError,
                                  QModbusClient::tr("Reply aborted due to connection closure."));
         }
-        m_transactionStore.clear();
     }
 
     // This doesn't overflow, it rather "wraps around". Expected.
@@ -223,12 +348,19 @@ public:
     QIODevice *device() const override { return m_socket; }
 
     QTcpSocket *m_socket = nullptr;
-    QByteArray responseBuffer;
-    QHash<quint16, QueueElement> m_transactionStore;
+    QModbusReceiveBuffer responseBuffer;
+    QList<Transaction> m_transactions;
+    qsizetype m_transactionCount = 0;
+    QQueue<Deadline> m_deadlines;
+    QTimer *m_timeoutTimer = nullptr;
+    QElapsedTimer m_clock;
     int mbpaHeaderSize = 7;
 
-private:   // Private to avoid using the wrong id inside the timer lambda,
-    quint16 m_transactionId = 0; // capturing 'this' will not copy the id.
+    static constexpr qsizetype MinimumTransactionSlots = 64;
+    static constexpr qsizetype MaximumTransactionSlots = 65536;
+
+private:
+    quint16 m_transactionId = 0;
 };
 
 QT_END_NAMESPACE
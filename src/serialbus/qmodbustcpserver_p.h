@@ -4,7 +4,6 @@
 #ifndef QMODBUSTCPSERVER_P_H
 #define QMODBUSTCPSERVER_P_H
 
-#include <QtCore/qdatastream.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qobject.h>
@@ -13,6 +12,7 @@
 #include <QtNetwork/qtcpsocket.h>
 #include <QtSerialBus/qmodbustcpserver.h>
 
+#include <private/qmodbusadu_p.h>
 #include <private/qmodbusserver_p.h>
 
 #include <memory>
@@ -99,7 +99,7 @@ public:
                 return;
             }
 
-            auto buffer = new QByteArray();
+            auto buffer = new QModbusReceiveBuffer();
 
             QObject::connect(socket, &QObject::destroyed, socket, [buffer]() {
                 // cleanup buffer
@@ -115,66 +115,66 @@ public:
                     return;
 
                 buffer->append(socket->readAll());
+
+                // Responses to all requests handled in this pass are written in one go.
+                QByteArray responses;
                 while (!buffer->isEmpty()) {
                     qCDebug(QT_MODBUS_LOW).noquote() << "(TCP server) Read buffer: 0x"
-                        + buffer->toHex();
+                        + buffer->rawData().toHex();
 
                     if (buffer->size() < mbpaHeaderSize) {
                         qCDebug(QT_MODBUS) << "(TCP server) MBPA header too short. Waiting for more data.";
-                        return;
+                        break;
                     }
 
-                    quint8 unitId;
-                    quint16 transactionId, bytesPdu, protocolId;
-                    QDataStream input(*buffer);
-                    input >> transactionId >> protocolId >> bytesPdu >> unitId;
+                    const QModbusTcpAdu::Header header
+                        = QModbusTcpAdu::readHeader(buffer->constData());
 
                     qCDebug(QT_MODBUS_LOW) << "(TCP server) Request MBPA:" << "Transaction Id:"
-                        << Qt::hex << transactionId << "Protocol Id:" << protocolId << "PDU bytes:"
-                        << bytesPdu << "Unit Id:" << unitId;
+                        << Qt::hex << header.transactionId << "Protocol Id:" << header.protocolId
+                        << "PDU bytes:" << header.length << "Unit Id:" << header.unitId;
 
                     // The length field is the byte count of the following fields, including the Unit
                     // Identifier and the PDU, so we remove on byte.
-                    bytesPdu--;
+                    const qsizetype bytesPdu = qMax(qsizetype(header.length) - 1, qsizetype(0));
 
-                    const quint16 current = mbpaHeaderSize + bytesPdu;
+                    const qsizetype current = mbpaHeaderSize + bytesPdu;
                     if (buffer->size() < current) {
                         qCDebug(QT_MODBUS) << "(TCP server) PDU too short. Waiting for more data";
-                        return;
+                        break;
                     }
 
-                    QModbusRequest request;
-                    input >> request;
+                    const QModbusRequest request = bytesPdu > 0
+                        ? buffer->pdu<QModbusRequest>(mbpaHeaderSize, bytesPdu)
+                        : QModbusRequest();
 
-                    buffer->remove(0, current);
+                    buffer->consume(current);
 
-                    if (!matchingServerAddress(unitId))
+                    if (!matchingServerAddress(header.unitId))
                         continue;
 
                     qCDebug(QT_MODBUS) << "(TCP server) Request PDU:" << request;
                     const QModbusResponse response = forwardProcessRequest(request);
                     qCDebug(QT_MODBUS) << "(TCP server) Response PDU:" << response;
 
-                    QByteArray result;
-                    QDataStream output(&result, QIODevice::WriteOnly);
-                    // The length field is the byte count of the following fields, including the Unit
-                    // Identifier and PDU fields, so we add one byte to the response size.
-                    output << transactionId << protocolId << quint16(response.size() + 1)
-                           << unitId << response;
-
-                    if (!socket->isOpen()) {
-                        qCDebug(QT_MODBUS) << "(TCP server) Requesting socket has closed.";
-                        forwardError(QModbusTcpServer::tr("Requesting socket is closed"),
-                                     QModbusDevice::WriteError);
-                        return;
-                    }
+                    QModbusTcpAdu::appendTo(responses, header, response);
+                }
 
-                    qint64 writtenBytes = socket->write(result);
-                    if (writtenBytes == -1 || writtenBytes < result.size()) {
-                        qCDebug(QT_MODBUS) << "(TCP server) Cannot write requested response to socket.";
-                        forwardError(QModbusTcpServer::tr("Could not write response to client"),
-                                     QModbusDevice::WriteError);
-                    }
+                if (responses.isEmpty())
+                    return;
+
+                if (!socket->isOpen()) {
+                    qCDebug(QT_MODBUS) << "(TCP server) Requesting socket has closed.";
+                    forwardError(QModbusTcpServer::tr("Requesting socket is closed"),
+                                 QModbusDevice::WriteError);
+                    return;
+                }
+
+                qint64 writtenBytes = socket->write(responses);
+                if (writtenBytes == -1 || writtenBytes < responses.size()) {
+                    qCDebug(QT_MODBUS) << "(TCP server) Cannot write requested response to socket.";
+                    forwardError(QModbusTcpServer::tr("Could not write response to client"),
+                                 QModbusDevice::WriteError);
                 }
             });
         });
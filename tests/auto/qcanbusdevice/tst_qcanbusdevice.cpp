@@ -3,6 +3,7 @@
 
 #include <QtSerialBus/qcanbusdevice.h>
 #include <QtSerialBus/qcanbusframe.h>
+#include <QtSerialBus/private/qcanbusframefilter_p.h>
 
 #include <QtCore/qtimer.h>
 #include <QtCore/QtPlugin>
@@ -10,6 +11,7 @@
 #include <QtTest/qtest.h>
 
 #include <memory>
+#include <thread>
 
 using namespace Qt::StringLiterals;
 
@@ -38,6 +40,16 @@ public:
         return true;
     }
 
+    void triggerNewFrames(const QList<QCanBusFrame> &frames)
+    {
+        enqueueReceivedFrames(frames);
+    }
+
+    void enableSoftwareFiltering(bool enabled)
+    {
+        setSoftwareFilteringEnabled(enabled);
+    }
+
     bool open() override
     {
         if (firstOpen) {
@@ -130,8 +142,14 @@ private slots:
     void initTestCase();
     void conf();
     void write();
+    void writeFrames();
     void read();
     void readAll();
+    void readFrames();
+    void receiveQueueOverflow_data();
+    void receiveQueueOverflow();
+    void receiveQueueBlockWhenFull();
+    void receiveNotificationCoalescing();
     void clearInputBuffer();
     void clearOutputBuffer();
     void error();
@@ -139,6 +157,7 @@ private slots:
     void tst_filtering();
     void filterEqual_data();
     void filterEqual();
+    void softwareFiltering();
     void tst_bufferingAttribute();
 
     void tst_waitForFramesReceived();
@@ -245,6 +264,35 @@ void tst_QCanBusDevice::write()
     QCOMPARE(spy.size(), 1);
 }
 
+void tst_QCanBusDevice::writeFrames()
+{
+    device->setWriteBuffered(false);
+
+    QSignalSpy spy(device.get(), &QCanBusDevice::framesWritten);
+
+    const QCanBusFrame frame(0x123, QByteArray("testData"));
+    const QList<QCanBusFrame> frames = { frame, frame, frame };
+
+    QCOMPARE(device->writeFrames(frames), 3);
+    QCOMPARE(device->error(), QCanBusDevice::NoError);
+    QCOMPARE(spy.size(), 3);
+    spy.clear();
+
+    QCOMPARE(device->writeFrames({}), 0);
+    QCOMPARE(spy.size(), 0);
+
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+
+    // writing stops at the first frame that fails
+    QCOMPARE(device->writeFrames(frames), 0);
+    QCOMPARE(device->error(), QCanBusDevice::OperationError);
+    QCOMPARE(spy.size(), 0);
+
+    device->connectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+}
+
 void tst_QCanBusDevice::read()
 {
     QSignalSpy stateSpy(device.get(), &QCanBusDevice::stateChanged);
@@ -295,6 +343,203 @@ void tst_QCanBusDevice::readAll()
     QVERIFY(!device->framesAvailable());
 }
 
+void tst_QCanBusDevice::readFrames()
+{
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+
+    QCanBusFrame buffer[4];
+    QCOMPARE(device->readFrames(buffer, 4), 0);
+    QCOMPARE(device->error(), QCanBusDevice::OperationError);
+
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+
+    QList<QCanBusFrame> frames;
+    for (QCanBusFrame::FrameId id = 1; id <= 6; ++id)
+        frames.append(QCanBusFrame(id, QByteArray("data")));
+    device->triggerNewFrames(frames);
+
+    QCOMPARE(device->readFrames(buffer, 4), 4);
+    QCOMPARE(device->error(), QCanBusDevice::NoError);
+    for (int i = 0; i < 4; ++i)
+        QCOMPARE(buffer[i].frameId(), QCanBusFrame::FrameId(i + 1));
+    QCOMPARE(device->framesAvailable(), 2);
+
+    // the same buffer can be reused
+    QCOMPARE(device->readFrames(QSpan<QCanBusFrame>(buffer)), 2);
+    QCOMPARE(buffer[0].frameId(), 5u);
+    QCOMPARE(buffer[1].frameId(), 6u);
+    QCOMPARE(buffer[1].payload(), QByteArray("data"));
+
+    QCOMPARE(device->readFrames(buffer, 4), 0);
+    QCOMPARE(device->error(), QCanBusDevice::NoError);
+}
+
+void tst_QCanBusDevice::receiveQueueOverflow_data()
+{
+    QTest::addColumn<QVariant>("policy");
+    QTest::addColumn<QList<QCanBusFrame::FrameId>>("expectedIds");
+
+    QTest::newRow("default") << QVariant() << QList<QCanBusFrame::FrameId>{ 1, 2, 3, 4 };
+    QTest::newRow("drop-newest") << QVariant::fromValue(QCanBusDevice::DropNewestFrames)
+                                 << QList<QCanBusFrame::FrameId>{ 1, 2, 3, 4 };
+    QTest::newRow("drop-oldest") << QVariant::fromValue(QCanBusDevice::DropOldestFrames)
+                                 << QList<QCanBusFrame::FrameId>{ 3, 4, 5, 6 };
+    // frames are enqueued in the device's thread, so blocking is not possible
+    QTest::newRow("block") << QVariant::fromValue(QCanBusDevice::BlockWhenFull)
+                           << QList<QCanBusFrame::FrameId>{ 1, 2, 3, 4 };
+}
+
+void tst_QCanBusDevice::receiveQueueOverflow()
+{
+    QFETCH(QVariant, policy);
+    QFETCH(QList<QCanBusFrame::FrameId>, expectedIds);
+
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueSizeKey, 4);
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey, policy);
+
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+    QCOMPARE(device->framesDropped(), 0);
+
+    QSignalSpy spy(device.get(), &QCanBusDevice::framesReceived);
+    QSignalSpy errorSpy(device.get(), &QCanBusDevice::errorOccurred);
+    QList<QCanBusFrame> frames;
+    for (QCanBusFrame::FrameId id = 1; id <= 6; ++id)
+        frames.append(QCanBusFrame(id, QByteArray("data")));
+    device->triggerNewFrames(frames);
+
+    QCOMPARE(spy.size(), 1);
+    QCOMPARE(device->framesAvailable(), 4);
+    QCOMPARE(device->framesDropped(), 2);
+    // the dropped frames are reported once until frames are read
+    QCOMPARE(errorSpy.size(), 1);
+    QCOMPARE(device->error(), QCanBusDevice::ReadError);
+    device->triggerNewFrames(frames);
+    QCOMPARE(device->framesDropped(), 8);
+    QCOMPARE(errorSpy.size(), 1);
+
+    QList<QCanBusFrame::FrameId> ids;
+    const QList<QCanBusFrame> received = device->readAllFrames();
+    for (const QCanBusFrame &frame : received)
+        ids.append(frame.frameId());
+    QCOMPARE(ids, expectedIds);
+    QCOMPARE(device->framesAvailable(), 0);
+
+    device->triggerNewFrames(frames);
+    QCOMPARE(errorSpy.size(), 2);
+
+    // restore the defaults
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueSizeKey, QVariant());
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey, QVariant());
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+}
+
+void tst_QCanBusDevice::receiveQueueBlockWhenFull()
+{
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueSizeKey, 4);
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey,
+                                      QVariant::fromValue(QCanBusDevice::BlockWhenFull));
+
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+
+    QList<QCanBusFrame> frames;
+    for (QCanBusFrame::FrameId id = 1; id <= 10; ++id)
+        frames.append(QCanBusFrame(id, QByteArray("data")));
+
+    // the producer thread waits until this thread made room for the remaining frames
+    std::atomic<bool> done = false;
+    std::thread producer([&]() {
+        device->triggerNewFrames(frames);
+        done = true;
+    });
+
+    QList<QCanBusFrame::FrameId> ids;
+    QTRY_VERIFY_WITH_TIMEOUT([&]() {
+        for (const QCanBusFrame &frame : device->readAllFrames())
+            ids.append(frame.frameId());
+        return done.load() && device->framesAvailable() == 0;
+    }(), 5000);
+    producer.join();
+
+    QCOMPARE(ids.size(), frames.size());
+    for (qsizetype i = 0; i < ids.size(); ++i)
+        QCOMPARE(ids.at(i), frames.at(i).frameId());
+    QCOMPARE(device->framesDropped(), 0);
+
+    // a producer which waits gives up when the device is disconnected
+    producer = std::thread([&]() { device->triggerNewFrames(frames); });
+    QTRY_COMPARE(device->framesAvailable(), 4);
+    device->disconnectDevice();
+    producer.join();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+    QCOMPARE(device->framesDropped(), 6);
+
+    // restore the defaults
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueSizeKey, QVariant());
+    device->setConfigurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey, QVariant());
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+}
+
+void tst_QCanBusDevice::receiveNotificationCoalescing()
+{
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+
+    device->setConfigurationParameter(QCanBusDevice::ReceiveNotificationIntervalKey, 50000);
+    device->setConfigurationParameter(QCanBusDevice::ReceiveNotificationThresholdKey, 8);
+
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+    QCOMPARE(device->receiveNotificationCount(), 0);
+    QCOMPARE(device->receivedFrameCount(), 0);
+
+    QSignalSpy spy(device.get(), &QCanBusDevice::framesReceived);
+    const QCanBusFrame frame(0x123, QByteArray("data"));
+
+    // below the threshold, the signal is delayed and emitted once
+    for (int i = 0; i < 4; ++i)
+        device->triggerNewFrames({ frame });
+    QCOMPARE(spy.size(), 0);
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(device->framesAvailable(), 4);
+    QCOMPARE(device->receiveNotificationCount(), 1);
+    QCOMPARE(device->receivedFrameCount(), 4);
+    device->readAllFrames();
+
+    // reaching the threshold emits the signal right away
+    for (int i = 0; i < 8; ++i)
+        device->triggerNewFrames({ frame });
+    QCOMPARE(spy.size(), 2);
+    QCOMPARE(device->receiveNotificationCount(), 2);
+    QCOMPARE(device->receivedFrameCount(), 12);
+    device->readAllFrames();
+
+    // the timer was stopped, so no late signal follows
+    QTest::qWait(100);
+    QCOMPARE(spy.size(), 2);
+
+    // restore the defaults
+    device->setConfigurationParameter(QCanBusDevice::ReceiveNotificationIntervalKey, QVariant());
+    device->setConfigurationParameter(QCanBusDevice::ReceiveNotificationThresholdKey, QVariant());
+    device->disconnectDevice();
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::UnconnectedState, 5000);
+    QVERIFY(device->connectDevice());
+    QTRY_VERIFY_WITH_TIMEOUT(device->state() == QCanBusDevice::ConnectedState, 5000);
+}
+
 void tst_QCanBusDevice::clearInputBuffer()
 {
     device->disconnectDevice();
@@ -525,6 +770,74 @@ void tst_QCanBusDevice::filterEqual()
     }
 }
 
+void tst_QCanBusDevice::softwareFiltering()
+{
+    using Filter = QCanBusDevice::Filter;
+
+    QList<Filter> filters(4);
+    // single base frame id, data frames only
+    filters[0].frameId = 0x123;
+    filters[0].frameIdMask = 0x7FF;
+    filters[0].type = QCanBusFrame::DataFrame;
+    filters[0].format = Filter::MatchBaseFormat;
+    // range of extended frame ids
+    filters[1].frameId = 0x18FF0000;
+    filters[1].frameIdMask = 0x1FFF0000;
+    filters[1].format = Filter::MatchExtendedFormat;
+    // covered by the range above
+    filters[2].frameId = 0x18FF1234;
+    filters[2].frameIdMask = 0x1FFFFFFF;
+    filters[2].format = Filter::MatchExtendedFormat;
+    // single extended frame id
+    filters[3].frameId = 0xABC;
+    filters[3].frameIdMask = 0x1FFFFFFF;
+    filters[3].format = Filter::MatchExtendedFormat;
+
+    const QList<Filter> merged = QCanBusFrameFilter::merged(filters);
+    QCOMPARE(merged.size(), 3);
+    QVERIFY(!merged.contains(filters.at(2)));
+
+    QList<QCanBusFrame> frames;
+    frames.append(QCanBusFrame(0x123, QByteArray("data")));
+    frames.append(QCanBusFrame(QCanBusFrame::RemoteRequestFrame));
+    frames.last().setFrameId(0x123);
+    frames.append(QCanBusFrame(0x124, QByteArray("data")));
+    frames.append(QCanBusFrame(0x18FF5678, QByteArray("data")));
+    frames.append(QCanBusFrame(0xABC, QByteArray("data")));
+    frames.append(QCanBusFrame(0xABD, QByteArray("data")));
+    frames.append(QCanBusFrame(0x123, QByteArray("data")));
+    frames.last().setExtendedFrameFormat(true);
+
+    auto receivedIds = [this]() {
+        QList<QCanBusFrame::FrameId> ids;
+        const QList<QCanBusFrame> received = device->readAllFrames();
+        for (const QCanBusFrame &frame : received)
+            ids.append(frame.frameId());
+        return ids;
+    };
+
+    device->clear(QCanBusDevice::Input);
+    device->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                      QVariant::fromValue(filters));
+    device->enableSoftwareFiltering(true);
+    device->triggerNewFrames(frames);
+    QCOMPARE(receivedIds(), (QList<QCanBusFrame::FrameId>{ 0x123, 0x18FF5678, 0xABC }));
+
+    // an empty list accepts all frames
+    device->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                      QVariant::fromValue(QList<Filter>()));
+    device->triggerNewFrames(frames);
+    QCOMPARE(device->readAllFrames().size(), frames.size());
+
+    device->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                      QVariant::fromValue(filters));
+    device->enableSoftwareFiltering(false);
+    device->triggerNewFrames(frames);
+    QCOMPARE(device->readAllFrames().size(), frames.size());
+
+    device->setConfigurationParameter(QCanBusDevice::RawFilterKey, QVariant());
+}
+
 void tst_QCanBusDevice::tst_bufferingAttribute()
 {
     std::unique_ptr<tst_Backend> canDevice(new tst_Backend);
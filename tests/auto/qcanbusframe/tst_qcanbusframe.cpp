@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtSerialBus/qcanbusframe.h>
+#include <QtSerialBus/private/qcanbusframe_p.h>
 
 #include <QtCore/qdatastream.h>
 #include <QtTest/qtest.h>
@@ -16,6 +17,7 @@ private slots:
     void constructors();
     void id();
     void payload();
+    void payloadArena();
     void timeStamp();
     void bitRateSwitch();
     void errorStateIndicator();
@@ -129,6 +131,47 @@ void tst_QCanBusFrame::payload()
     frame.setPayload("test");
     QCOMPARE(frame.payload().data(), "test");
     QVERIFY(frame.hasFlexibleDataRateFormat());
+    QCOMPARE(frame.payloadView().toByteArray(), QByteArray("test"));
+    QVERIFY(frame.payloadView().data() == frame.payload().constData());
+}
+
+void tst_QCanBusFrame::payloadArena()
+{
+    QCanBusFramePayloadArena arena(32);
+    QList<QByteArray> payloads;
+
+    // three payloads of 8 bytes plus terminator fit into one block
+    for (char c = 'a'; c < 'f'; ++c) {
+        const QByteArray data(8, c);
+        payloads.append(arena.payload(data.constData(), data.size()));
+    }
+
+    for (qsizetype i = 0; i < payloads.size(); ++i) {
+        QCOMPARE(payloads.at(i), QByteArray(8, char('a' + i)));
+        QCOMPARE(payloads.at(i).constData()[8], '\0');
+    }
+    QVERIFY(payloads.at(0).constData() + 9 == payloads.at(1).constData());
+    QVERIFY(payloads.at(1).constData() + 9 == payloads.at(2).constData());
+    QVERIFY(payloads.at(2).constData() + 9 != payloads.at(3).constData());
+
+    // modifying a slice must not touch its neighbors
+    payloads[1][0] = 'x';
+    QCOMPARE(payloads.at(0), QByteArray(8, 'a'));
+    QCOMPARE(payloads.at(1), QByteArray("xbbbbbbb"));
+    QCOMPARE(payloads.at(2), QByteArray(8, 'c'));
+
+    // the block survives the arena
+    arena.clear();
+    QCOMPARE(payloads.at(0), QByteArray(8, 'a'));
+
+    // empty and oversized payloads
+    QVERIFY(arena.payload("", 0).isEmpty());
+    const QByteArray large(64, 'z');
+    QCOMPARE(arena.payload(large.constData(), large.size()), large);
+
+    QCanBusFrame frame;
+    frame.setPayload(payloads.at(2));
+    QCOMPARE(frame.payloadView().toByteArray(), QByteArray(8, 'c'));
 }
 
 void tst_QCanBusFrame::timeStamp()
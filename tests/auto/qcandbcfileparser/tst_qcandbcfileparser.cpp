@@ -3,6 +3,8 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/qtemporarydir.h>
+
 #include <QtSerialBus/QCanDbcFileParser>
 #include <QtSerialBus/QCanMessageDescription>
 #include <QtSerialBus/QCanSignalDescription>
@@ -27,6 +29,10 @@ private slots:
     void parseFile();
     void valueDescriptions();
     void resetState();
+    void multipleFiles();
+    void cache();
+    void feed();
+    void sharedStrings();
 
 private:
     QString m_filesDir;
@@ -784,6 +790,47 @@ void tst_QCanDbcFileParser::parseFile_data()
                 << expectedWarnings << descriptions;
     }
 
+    {
+        // The file uses UTF-8 encoding and CRLF line endings
+        QCanMessageDescription utf8MessageDesc;
+        utf8MessageDesc.setName(u"Nachricht_Ä"_s);
+        utf8MessageDesc.setUniqueId(QtCanBus::UniqueId{1234});
+        utf8MessageDesc.setSize(2);
+        utf8MessageDesc.setTransmitter(u"Steuergerät"_s);
+
+        QCanSignalDescription signalDesc;
+        signalDesc.setName(u"Geschwindigkeit"_s);
+        signalDesc.setDataEndian(QSysInfo::Endian::LittleEndian);
+        signalDesc.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+        signalDesc.setDataSource(QtCanBus::DataSource::Payload);
+        signalDesc.setStartBit(0);
+        signalDesc.setBitLength(8);
+        signalDesc.setFactor(1.0);
+        signalDesc.setOffset(0.0);
+        signalDesc.setRange(0.0, 0.0);
+        signalDesc.setPhysicalUnit(u"km/h"_s);
+        signalDesc.setReceiver(u"Empfänger"_s);
+        utf8MessageDesc.addSignalDescription(signalDesc);
+
+        signalDesc.setName(u"Temperatur_Ω"_s);
+        signalDesc.setStartBit(8);
+        signalDesc.setPhysicalUnit(u"°C"_s);
+        signalDesc.setReceiver(u"Vector__XXX"_s);
+        signalDesc.setComment(u"Température"_s);
+        utf8MessageDesc.addSignalDescription(signalDesc);
+
+        // DBC identifiers consist of at least two characters
+        expectedWarnings = {
+            u"Failed to find signal description in string SG_ Ö : 8|8@1+ (1,0) [0|0] "
+             "\"°C\" Vector__XXX"_s,
+        };
+
+        QTest::addRow("utf8 names")
+                << QStringList{ u"utf8_names.dbc"_s }
+                << QCanDbcFileParser::Error::None << QString()
+                << expectedWarnings << QList<QCanMessageDescription>{ utf8MessageDesc };
+    }
+
     {
         const QString fileName = u"invalid_message_pos.dbc"_s;
         const QString expectedError = u"Failed to parse file %1. Unexpected position "
@@ -1074,6 +1121,271 @@ void tst_QCanDbcFileParser::resetState()
     QVERIFY(parser.messageValueDescriptions().isEmpty());
 }
 
+void tst_QCanDbcFileParser::multipleFiles()
+{
+    QFETCH_GLOBAL(bool, readFromFile);
+    if (!readFromFile)
+        QSKIP("parseData() does not support multiple files");
+
+    const QStringList fileNames{ m_filesDir + u"multiple_files_1.dbc"_s,
+                                 m_filesDir + u"multiple_files_2.dbc"_s };
+    QCanDbcFileParser parser;
+    QVERIFY(parser.parse(fileNames));
+
+    auto statistics = parser.fileStatistics();
+    QCOMPARE(statistics.size(), 2);
+    QCOMPARE(statistics.at(0).fileName, fileNames.at(0));
+    QCOMPARE(statistics.at(0).messageCount, 1);
+    QCOMPARE(statistics.at(0).warningCount, 1);
+    QCOMPARE(statistics.at(1).fileName, fileNames.at(1));
+    QCOMPARE(statistics.at(1).messageCount, 1);
+    QCOMPARE(statistics.at(1).warningCount, 2);
+
+    // The second file redefines the message from the first file, and adds a
+    // comment to its signal. The results must be the same as if the files
+    // were parsed one after another.
+    const QString otherFileName = m_filesDir + u"multiple_files_3.dbc"_s;
+    QVERIFY(parser.parse(QStringList{ fileNames.at(0), otherFileName }));
+
+    const QStringList expectedWarnings {
+        u"Failed to find signal description in string "
+         "SG_ Singal%1 : 0|8@1+ (1,0) [0|0] \"unit\" Vector__XXX"_s,
+        u"Message description with unique id 1234 is skipped because such unique id "
+         "is already used."_s,
+    };
+    QCOMPARE(parser.warnings(), expectedWarnings);
+
+    const auto messageDescriptions = parser.messageDescriptions();
+    QCOMPARE(messageDescriptions.size(), 1);
+    const auto signalDesc = messageDescriptions.first().signalDescriptionForName(u"Signal0"_s);
+    QCOMPARE(signalDesc.dataFormat(), QtCanBus::DataFormat::Float);
+    QCOMPARE(signalDesc.comment(), u"Comment for Signal0"_s);
+
+    statistics = parser.fileStatistics();
+    QCOMPARE(statistics.size(), 2);
+    QCOMPARE(statistics.at(1).fileName, otherFileName);
+    QCOMPARE(statistics.at(1).messageCount, 0);
+    QCOMPARE(statistics.at(1).warningCount, 1);
+
+    // The statistics are reset with the next parsing
+    QVERIFY(parser.parseData(u"BO_ 1234 Test : 4 Vector__XXX"_s));
+    QVERIFY(parser.fileStatistics().isEmpty());
+}
+
+void tst_QCanDbcFileParser::cache()
+{
+    QFETCH_GLOBAL(bool, readFromFile);
+    if (!readFromFile)
+        QSKIP("The cache can only be created for files");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFileName = dir.filePath(u"cache.bin"_s);
+
+    // Copy the files, so that we can modify them
+    QStringList fileNames;
+    for (const auto &name : { u"extended_multiplexing.dbc"_s, u"value_descriptions.dbc"_s }) {
+        fileNames.push_back(dir.filePath(name));
+        QVERIFY(QFile::copy(m_filesDir + name, fileNames.back()));
+        QVERIFY(QFile::setPermissions(fileNames.back(),
+                                      QFile::ReadOwner | QFile::WriteOwner));
+    }
+
+    QCanDbcFileParser parser;
+    // nothing to save yet
+    QVERIFY(!parser.saveCache(cacheFileName));
+    QVERIFY(!parser.loadCache(cacheFileName, fileNames));
+    QCOMPARE(parser.error(), QCanDbcFileParser::Error::InvalidCache);
+
+    QVERIFY(parser.parse(fileNames));
+    QVERIFY(parser.saveCache(cacheFileName));
+
+    auto uidComparator = [](const QCanMessageDescription &lhs, const QCanMessageDescription &rhs) {
+        return lhs.uniqueId() < rhs.uniqueId();
+    };
+    auto expectedDescriptions = parser.messageDescriptions();
+    std::sort(expectedDescriptions.begin(), expectedDescriptions.end(), uidComparator);
+
+    QCanDbcFileParser cachedParser;
+    QVERIFY(cachedParser.loadCache(cacheFileName, fileNames));
+    QCOMPARE(cachedParser.error(), QCanDbcFileParser::Error::None);
+    auto descriptions = cachedParser.messageDescriptions();
+    std::sort(descriptions.begin(), descriptions.end(), uidComparator);
+    QVERIFY(equals(descriptions, expectedDescriptions));
+    QCOMPARE(cachedParser.messageValueDescriptions(), parser.messageValueDescriptions());
+    QCOMPARE(cachedParser.warnings(), parser.warnings());
+
+    // The cache of the parsed data can't be checked against the files
+    QVERIFY(parser.parseData(u"BO_ 1234 Test : 1 Vector__XXX\n SG_ s0 : 0|8@1+ (1,0) [0|0] "
+                              "\"unit\" Vector__XXX"_s));
+    QVERIFY(!parser.saveCache(cacheFileName));
+
+    // Modify one of the files
+    {
+        QFile f(fileNames.back());
+        QVERIFY(f.open(QIODevice::Append));
+        f.write("\nCM_ \"Modified\";\n");
+    }
+    QVERIFY(!cachedParser.loadCache(cacheFileName, fileNames));
+    QCOMPARE(cachedParser.error(), QCanDbcFileParser::Error::InvalidCache);
+    QCOMPARE(cachedParser.errorString(), u"Cache file %1 is outdated."_s.arg(cacheFileName));
+    QVERIFY(cachedParser.messageDescriptions().isEmpty());
+
+    // Different list of files
+    QVERIFY(!cachedParser.loadCache(cacheFileName, fileNames.first(1)));
+    QCOMPARE(cachedParser.error(), QCanDbcFileParser::Error::InvalidCache);
+
+    // Corrupted cache file
+    QVERIFY(parser.parse(fileNames));
+    QVERIFY(parser.saveCache(cacheFileName));
+    {
+        QFile f(cacheFileName);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.resize(f.size() / 2));
+    }
+    QVERIFY(!cachedParser.loadCache(cacheFileName, fileNames));
+    QCOMPARE(cachedParser.error(), QCanDbcFileParser::Error::InvalidCache);
+    QCOMPARE(cachedParser.errorString(), u"Cache file %1 is corrupted."_s.arg(cacheFileName));
+}
+
+void tst_QCanDbcFileParser::feed()
+{
+    QFETCH_GLOBAL(bool, readFromFile);
+    if (!readFromFile)
+        QSKIP("The data is fed from the files");
+
+    auto uidComparator = [](const QCanMessageDescription &lhs, const QCanMessageDescription &rhs) {
+        return lhs.uniqueId() < rhs.uniqueId();
+    };
+
+    // Small chunks split the lines at arbitrary positions, also inside of
+    // multibyte UTF-8 characters and the UTF-8 BOM.
+    for (const auto &name : { u"extended_multiplexing.dbc"_s, u"value_descriptions.dbc"_s,
+                              u"utf8_names.dbc"_s, u"utf8_bom.dbc"_s,
+                              u"invalid_message_pos.dbc"_s }) {
+        QFile f(m_filesDir + name);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        const QByteArray data = f.readAll();
+
+        QCanDbcFileParser expectedParser;
+        const bool expectedResult = expectedParser.parse(m_filesDir + name);
+        auto expectedDescriptions = expectedParser.messageDescriptions();
+        std::sort(expectedDescriptions.begin(), expectedDescriptions.end(), uidComparator);
+
+        for (qsizetype chunkSize : { 1, 5, 64 }) {
+            QCanDbcFileParser parser;
+            bool result = true;
+            for (qsizetype pos = 0; result && pos < data.size(); pos += chunkSize)
+                result = parser.feed(QByteArrayView(data).sliced(pos).first(
+                                         qMin(chunkSize, data.size() - pos)));
+            if (result)
+                result = parser.finishFeed();
+
+            QCOMPARE(result, expectedResult);
+            QCOMPARE(parser.error(), expectedParser.error());
+            auto descriptions = parser.messageDescriptions();
+            std::sort(descriptions.begin(), descriptions.end(), uidComparator);
+            QVERIFY(equals(descriptions, expectedDescriptions));
+            QCOMPARE(parser.messageValueDescriptions(),
+                     expectedParser.messageValueDescriptions());
+            QCOMPARE(parser.warnings(), expectedParser.warnings());
+        }
+    }
+
+    // The BOM is skipped, so the first message is found
+    {
+        QCanDbcFileParser withoutBom;
+        QVERIFY(withoutBom.parse(m_filesDir + u"utf8_names.dbc"_s));
+        QCanDbcFileParser withBom;
+        QVERIFY(withBom.feed("\xEF\xBB"));
+        QVERIFY(withBom.feed("\xBF" "BO_ 1234 Nachricht_"));
+        QFile f(m_filesDir + u"utf8_names.dbc"_s);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        QVERIFY(withBom.feed(f.readAll().sliced(qstrlen("BO_ 1234 Nachricht_"))));
+        QVERIFY(withBom.finishFeed());
+        QCOMPARE(withBom.messageDescriptions().size(), 1);
+        QVERIFY(equals(withBom.messageDescriptions(), withoutBom.messageDescriptions()));
+        QCOMPARE(withBom.warnings(), withoutBom.warnings());
+    }
+
+    // A new feed() after finishFeed() starts from scratch
+    QCanDbcFileParser parser;
+    QVERIFY(parser.feed("BO_ 1234 Test : 1 Vector__XXX\n SG_ s0 : 0|8@1+ (1,0) [0|0] "));
+    QVERIFY(parser.messageDescriptions().isEmpty());
+    QVERIFY(parser.feed("\"unit\" Vector__XXX"));
+    QVERIFY(parser.finishFeed());
+    QCOMPARE(parser.messageDescriptions().size(), 1);
+    QVERIFY(parser.feed("BO_ 1235 Test2 : 1 Vector__XXX\n"));
+    QVERIFY(parser.finishFeed());
+    QCOMPARE(parser.messageDescriptions().size(), 1);
+    QCOMPARE(parser.messageDescriptions().constFirst().uniqueId(), QtCanBus::UniqueId{1235});
+}
+
+void tst_QCanDbcFileParser::sharedStrings()
+{
+    QFETCH_GLOBAL(bool, readFromFile);
+
+    // The repeated strings must share their data
+    const QString fileName = u"value_descriptions.dbc"_s;
+    QCanDbcFileParser parser;
+    QVERIFY(parseHelper(&parser, m_filesDir + fileName, readFromFile));
+
+    const auto messages = parser.messageDescriptions();
+    QCOMPARE(messages.size(), 2);
+    const auto first = messages.at(0).signalDescriptionForName(u"s1"_s);
+    const auto second = messages.at(1).signalDescriptionForName(u"s1"_s);
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+    QCOMPARE(first.name().constData(), second.name().constData());
+    QCOMPARE(first.receiver().constData(), second.receiver().constData());
+    QCOMPARE(messages.at(0).transmitter().constData(), messages.at(1).transmitter().constData());
+    QCOMPARE(messages.at(0).transmitter().constData(), first.receiver().constData());
+
+    // units and value descriptions as well, also when loaded from the cache
+    auto messageFor = [](const QCanDbcFileParser &parser, QtCanBus::UniqueId uid) {
+        const auto messages = parser.messageDescriptions();
+        const auto it = std::find_if(messages.cbegin(), messages.cend(),
+                                     [uid](const QCanMessageDescription &message) {
+            return message.uniqueId() == uid;
+        });
+        return it != messages.cend() ? *it : QCanMessageDescription();
+    };
+    auto verifyShared = [&messageFor](const QCanDbcFileParser &parser) {
+        const QCanMessageDescription speed = messageFor(parser, QtCanBus::UniqueId{256});
+        const QCanMessageDescription limit = messageFor(parser, QtCanBus::UniqueId{257});
+        QVERIFY(speed.isValid());
+        QVERIFY(limit.isValid());
+        const QString unit = speed.signalDescriptionForName(u"speed"_s).physicalUnit();
+        QCOMPARE(unit, u"km/h"_s);
+        QCOMPARE(limit.signalDescriptionForName(u"speed"_s).physicalUnit().constData(),
+                 unit.constData());
+
+        const auto valueDescriptions = parser.messageValueDescriptions();
+        const QString on = valueDescriptions.value(QtCanBus::UniqueId{256})
+                .value(u"state"_s).value(1);
+        QCOMPARE(on, u"On"_s);
+        QCOMPARE(valueDescriptions.value(QtCanBus::UniqueId{257}).value(u"state"_s).value(1)
+                 .constData(), on.constData());
+    };
+
+    const QString sharedFileName = m_filesDir + u"shared_strings.dbc"_s;
+    QCanDbcFileParser sharedParser;
+    QVERIFY(parseHelper(&sharedParser, sharedFileName, readFromFile));
+    QCOMPARE(sharedParser.messageDescriptions().size(), 2);
+    verifyShared(sharedParser);
+    if (QTest::currentTestFailed() || !readFromFile)
+        return;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cacheFileName = dir.filePath(u"cache.bin"_s);
+    QVERIFY(sharedParser.saveCache(cacheFileName));
+    QCanDbcFileParser cachedParser;
+    QVERIFY(cachedParser.loadCache(cacheFileName, { sharedFileName }));
+    QCOMPARE(cachedParser.messageDescriptions().size(), 2);
+    verifyShared(cachedParser);
+}
+
 QTEST_MAIN(tst_QCanDbcFileParser)
 
 #include "tst_qcandbcfileparser.moc"
@@ -3,6 +3,7 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/QRandomGenerator>
 #include <QtCore/QtEndian>
 
 #include <QtSerialBus/qcanbusframe.h>
@@ -11,8 +12,12 @@
 #include <QtSerialBus/qcansignaldescription.h>
 #include <QtSerialBus/private/qcanframeprocessor_p.h>
 
+#include <cmath>
+
 QT_USE_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 class tst_QCanFrameProcessor : public QObject
 {
     Q_OBJECT
@@ -40,6 +45,17 @@ private slots:
     void extractUniqueId_data();
     void extractUniqueId();
 
+    void parseMatchesBitwiseExtraction_data();
+    void parseMatchesBitwiseExtraction();
+
+    void parseIntoValues_data();
+    void parseIntoValues();
+    void signalIndices();
+    void updateMessageDescriptions();
+    void decodeFrames();
+    void prepareFrameFromValues();
+    void parseColumn();
+
     /* generate */
     void prepareFrame_data();
     void prepareFrame();
@@ -992,6 +1008,644 @@ void tst_QCanFrameProcessor::extractUniqueId()
     QCOMPARE(result.uniqueId, expectedUniqueId);
 }
 
+void tst_QCanFrameProcessor::parseMatchesBitwiseExtraction_data()
+{
+    QTest::addColumn<QtCanBus::DataFormat>("format");
+    QTest::addColumn<QSysInfo::Endian>("endian");
+
+    QTest::newRow("signed LE")
+            << QtCanBus::DataFormat::SignedInteger << QSysInfo::Endian::LittleEndian;
+    QTest::newRow("signed BE")
+            << QtCanBus::DataFormat::SignedInteger << QSysInfo::Endian::BigEndian;
+    QTest::newRow("unsigned LE")
+            << QtCanBus::DataFormat::UnsignedInteger << QSysInfo::Endian::LittleEndian;
+    QTest::newRow("unsigned BE")
+            << QtCanBus::DataFormat::UnsignedInteger << QSysInfo::Endian::BigEndian;
+}
+
+void tst_QCanFrameProcessor::parseMatchesBitwiseExtraction()
+{
+    // The frame processor extracts most signals with word operations. Compare
+    // the results with the bitwise extraction for all start bits and lengths.
+    QFETCH(QtCanBus::DataFormat, format);
+    QFETCH(QSysInfo::Endian, endian);
+
+    constexpr qsizetype payloadSize = 16;
+    QByteArray payload(payloadSize, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payloadSize; ++i)
+        payload[i] = char(0x5A ^ (i * 37));
+    const auto *data = reinterpret_cast<const unsigned char *>(payload.constData());
+
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setSource(QtCanBus::DataSource::FrameId);
+    uidDesc.setStartBit(0);
+    uidDesc.setBitLength(8);
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    auto *processorPrivate = QCanFrameProcessorPrivate::get(processor);
+
+    const QCanBusFrame frame(0x12, payload);
+    for (quint16 length = 1; length <= 64; ++length) {
+        for (quint16 startBit = 0; startBit < payloadSize * 8; ++startBit) {
+            QCanSignalDescription sig;
+            sig.setName("s");
+            sig.setDataFormat(format);
+            sig.setDataEndian(endian);
+            sig.setStartBit(startBit);
+            sig.setBitLength(length);
+
+            QCanMessageDescription message;
+            message.setName("m");
+            message.setUniqueId(QtCanBus::UniqueId{0x12});
+            message.setSize(payloadSize);
+            message.addSignalDescription(sig);
+            processor.setMessageDescriptions({ message });
+
+            const auto result = processor.parseFrame(frame);
+            if (!processor.warnings().isEmpty())
+                continue; // the signal does not fit into the payload
+
+            const QVariant expected = processorPrivate->parseData(data, sig);
+            QVERIFY2(result.signalValues.value(u"s"_s) == expected,
+                     qPrintable(u"start bit %1, length %2"_s.arg(startBit).arg(length)));
+        }
+    }
+}
+
+void tst_QCanFrameProcessor::parseIntoValues_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("s1 active") << QByteArray::fromHex("01c3415a0000c03f");
+    QTest::newRow("s2 active") << QByteArray::fromHex("02fe7f5a000020c1");
+    QTest::newRow("no mux match") << QByteArray::fromHex("0f80005a00000000");
+    QTest::newRow("negative") << QByteArray::fromHex("01ffff5a0080bfc3");
+}
+
+void tst_QCanFrameProcessor::parseIntoValues()
+{
+    // The values written into the span must match the values of the
+    // QVariantMap result, and the values of inactive signals must be kept.
+    QFETCH(QByteArray, payload);
+
+    QCanSignalDescription s0; // multiplexor
+    s0.setName("s0");
+    s0.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+    s0.setStartBit(0);
+    s0.setBitLength(4);
+    s0.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
+
+    QCanSignalDescription s1; // used when s0 == 1
+    s1.setName("s1");
+    s1.setDataFormat(QtCanBus::DataFormat::SignedInteger);
+    s1.setDataEndian(QSysInfo::Endian::BigEndian);
+    s1.setStartBit(15);
+    s1.setBitLength(16);
+    s1.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    s1.addMultiplexSignal(s0.name(), 1);
+
+    QCanSignalDescription s2; // used when s0 == 2
+    s2.setName("s2");
+    s2.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+    s2.setStartBit(8);
+    s2.setBitLength(16);
+    s2.setFactor(0.25);
+    s2.setOffset(-10);
+    s2.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    s2.addMultiplexSignal(s0.name(), 2);
+
+    QCanSignalDescription s3;
+    s3.setName("s3");
+    s3.setDataFormat(QtCanBus::DataFormat::AsciiString);
+    s3.setStartBit(24);
+    s3.setBitLength(8);
+
+    QCanSignalDescription s4;
+    s4.setName("s4");
+    s4.setDataFormat(QtCanBus::DataFormat::Float);
+    s4.setStartBit(32);
+    s4.setBitLength(32);
+
+    const QtCanBus::UniqueId uniqueId{0x123};
+
+    QCanMessageDescription msg;
+    msg.setName("test");
+    msg.setUniqueId(uniqueId);
+    msg.setSize(payload.size());
+    msg.setSignalDescriptions({ s0, s1, s2, s3, s4 });
+
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setBitLength(11);
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    processor.addMessageDescriptions({ msg });
+    QCOMPARE(processor.signalIndexCount(), 5);
+
+    const QCanBusFrame frame(qToUnderlying(uniqueId), payload);
+    const QVariantMap expected = processor.parseFrame(frame).signalValues;
+    QVERIFY(!expected.isEmpty());
+
+    constexpr double untouchedDouble = 42.5;
+    constexpr qint64 untouchedInt = 42;
+    QList<double> doubleValues(processor.signalIndexCount(), untouchedDouble);
+    QList<qint64> intValues(processor.signalIndexCount(), untouchedInt);
+    const qsizetype doubleCount = processor.parseFrame(frame, doubleValues);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+    const qsizetype intCount = processor.parseFrame(frame, intValues);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+
+    // ASCII signals are only part of the QVariantMap result
+    QCOMPARE(doubleCount, expected.size() - 1);
+    QCOMPARE(intCount, doubleCount);
+
+    for (const QString &name : { u"s0"_s, u"s1"_s, u"s2"_s, u"s4"_s }) {
+        const qsizetype index = processor.signalIndex(uniqueId, name);
+        QVERIFY(index >= 0);
+        const auto it = expected.constFind(name);
+        if (it == expected.cend()) {
+            QCOMPARE(doubleValues.at(index), untouchedDouble);
+            QCOMPARE(intValues.at(index), untouchedInt);
+        } else {
+            QCOMPARE(doubleValues.at(index), it->toDouble());
+            QCOMPARE(intValues.at(index), qint64(std::llround(it->toDouble())));
+        }
+    }
+    const qsizetype asciiIndex = processor.signalIndex(uniqueId, u"s3"_s);
+    QCOMPARE(doubleValues.at(asciiIndex), untouchedDouble);
+    QCOMPARE(intValues.at(asciiIndex), untouchedInt);
+
+    // the values must fit into the span
+    QList<double> tooSmall(processor.signalIndexCount() - 1);
+    QCOMPARE(processor.parseFrame(frame, tooSmall), -1);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Decoding);
+}
+
+void tst_QCanFrameProcessor::signalIndices()
+{
+    auto makeMessage = [](quint32 uniqueId, const QStringList &signalNames) {
+        QCanMessageDescription msg;
+        msg.setName(u"m%1"_s.arg(uniqueId));
+        msg.setUniqueId(QtCanBus::UniqueId{uniqueId});
+        msg.setSize(8);
+        quint16 startBit = 0;
+        for (const QString &name : signalNames) {
+            QCanSignalDescription sig;
+            sig.setName(name);
+            sig.setStartBit(startBit);
+            sig.setBitLength(8);
+            msg.addSignalDescription(sig);
+            startBit += 8;
+        }
+        return msg;
+    };
+
+    QCanFrameProcessor processor;
+    QCOMPARE(processor.signalIndexCount(), 0);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"a"_s), -1);
+
+    processor.setMessageDescriptions({ makeMessage(1, { u"a"_s, u"b"_s }),
+                                       makeMessage(2, { u"a"_s, u"c"_s, u"d"_s }) });
+    QCOMPARE(processor.signalIndexCount(), 5);
+
+    // all indices are distinct and within range
+    QList<qsizetype> indices;
+    for (const QString &name : { u"a"_s, u"b"_s })
+        indices.append(processor.signalIndex(QtCanBus::UniqueId{1}, name));
+    for (const QString &name : { u"a"_s, u"c"_s, u"d"_s })
+        indices.append(processor.signalIndex(QtCanBus::UniqueId{2}, name));
+    std::sort(indices.begin(), indices.end());
+    QCOMPARE(indices, QList<qsizetype>({ 0, 1, 2, 3, 4 }));
+
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"c"_s), -1);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{3}, u"a"_s), -1);
+
+    // adding the same message again keeps its indices
+    const qsizetype index1a = processor.signalIndex(QtCanBus::UniqueId{1}, u"a"_s);
+    const qsizetype index1b = processor.signalIndex(QtCanBus::UniqueId{1}, u"b"_s);
+    const qsizetype index2a = processor.signalIndex(QtCanBus::UniqueId{2}, u"a"_s);
+    processor.addMessageDescriptions({ makeMessage(1, { u"b"_s, u"a"_s }) });
+    QCOMPARE(processor.signalIndexCount(), 5);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"a"_s), index1a);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"b"_s), index1b);
+
+    // replacing a message keeps the indices of the other messages and of the
+    // signals which are still there, removed indices are reused
+    processor.addMessageDescriptions({ makeMessage(1, { u"b"_s, u"e"_s }) });
+    QCOMPARE(processor.signalIndexCount(), 5);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"b"_s), index1b);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"e"_s), index1a);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{1}, u"a"_s), -1);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{2}, u"a"_s), index2a);
+
+    // replacing messages again and again does not grow the range
+    for (int i = 0; i < 10; ++i) {
+        processor.addMessageDescriptions({ makeMessage(1, { u"x%1"_s.arg(i) }) });
+        QVERIFY(processor.signalIndexCount() <= 5);
+    }
+    const qsizetype index1x = processor.signalIndex(QtCanBus::UniqueId{1}, u"x9"_s);
+    QVERIFY(index1x >= 0 && index1x < processor.signalIndexCount());
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{2}, u"a"_s), index2a);
+
+    processor.clearMessageDescriptions();
+    QCOMPARE(processor.signalIndexCount(), 0);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{2}, u"a"_s), -1);
+}
+
+void tst_QCanFrameProcessor::updateMessageDescriptions()
+{
+    auto makeMessage = [](quint32 uniqueId, double factor) {
+        QCanMessageDescription msg;
+        msg.setName(u"m%1"_s.arg(uniqueId));
+        msg.setUniqueId(QtCanBus::UniqueId{uniqueId});
+        msg.setSize(2);
+        for (quint16 i = 0; i < 2; ++i) {
+            QCanSignalDescription sig;
+            sig.setName(u"s%1"_s.arg(i));
+            sig.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+            sig.setDataEndian(QSysInfo::Endian::LittleEndian);
+            sig.setStartBit(i * 8);
+            sig.setBitLength(8);
+            sig.setFactor(factor);
+            msg.addSignalDescription(sig);
+        }
+        return msg;
+    };
+
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setSource(QtCanBus::DataSource::FrameId);
+    uidDesc.setEndian(QSysInfo::Endian::LittleEndian);
+    uidDesc.setStartBit(0);
+    uidDesc.setBitLength(11);
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    QCOMPARE(processor.updateMessageDescriptions({ makeMessage(1, 1.0), makeMessage(2, 1.0),
+                                                   makeMessage(3, 1.0) }), 3);
+    QCOMPARE(processor.messageDescriptions().size(), 3);
+    QCOMPARE(processor.signalIndexCount(), 6);
+
+    auto indicesOf = [&processor](quint32 uniqueId, const QStringList &names) {
+        QList<qsizetype> indices;
+        for (const QString &name : names)
+            indices.append(processor.signalIndex(QtCanBus::UniqueId{uniqueId}, name));
+        return indices;
+    };
+    const QStringList names = { u"s0"_s, u"s1"_s };
+    const QList<qsizetype> indices1 = indicesOf(1, names);
+    const QList<qsizetype> indices2 = indicesOf(2, names);
+    QList<qsizetype> indices3 = indicesOf(3, names);
+
+    // Message 1 is created again, but it is the same. Message 2 changes,
+    // message 3 is removed, and message 4 is added.
+    QCOMPARE(processor.updateMessageDescriptions({ makeMessage(1, 1.0), makeMessage(2, 2.0),
+                                                   makeMessage(4, 1.0) }), 3);
+    QCOMPARE(processor.messageDescriptions().size(), 3);
+    QCOMPARE(indicesOf(1, names), indices1);
+    QCOMPARE(indicesOf(2, names), indices2);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{3}, u"s0"_s), -1);
+    // the indices of the removed message are reused
+    QList<qsizetype> indices4 = indicesOf(4, names);
+    std::sort(indices3.begin(), indices3.end());
+    std::sort(indices4.begin(), indices4.end());
+    QCOMPARE(indices4, indices3);
+    QCOMPARE(processor.signalIndexCount(), 6);
+
+    const QCanBusFrame frame(2, QByteArray::fromHex("0a14"));
+    const auto result = processor.parseFrame(frame);
+    QCOMPARE(result.uniqueId, QtCanBus::UniqueId{2});
+    QCOMPARE(result.signalValues.value(u"s0"_s).toDouble(), 20.0);
+    QCOMPARE(result.signalValues.value(u"s1"_s).toDouble(), 40.0);
+
+    // nothing changes
+    QCOMPARE(processor.updateMessageDescriptions({ makeMessage(4, 1.0), makeMessage(2, 2.0),
+                                                   makeMessage(1, 1.0) }), 0);
+    QCOMPARE(processor.signalIndexCount(), 6);
+
+    // A signal of message 2 is renamed, and a signal is added. The signal which
+    // is still there keeps its index, no matter where it ends up in the message.
+    QCanMessageDescription changed = makeMessage(2, 2.0);
+    QCanSignalDescription renamed = changed.signalDescriptionForName(u"s0"_s);
+    renamed.setName(u"s2"_s);
+    QCanSignalDescription added = renamed;
+    added.setName(u"s3"_s);
+    changed.setSignalDescriptions({ added, changed.signalDescriptionForName(u"s1"_s),
+                                    renamed });
+    QCOMPARE(processor.updateMessageDescriptions({ makeMessage(1, 1.0), changed,
+                                                   makeMessage(4, 1.0) }), 1);
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{2}, u"s1"_s), indices2.at(1));
+    QCOMPARE(processor.signalIndex(QtCanBus::UniqueId{2}, u"s0"_s), -1);
+    QCOMPARE(indicesOf(1, names), indices1);
+    QCOMPARE(processor.signalIndexCount(), 7);
+    QList<qsizetype> all = indicesOf(1, names) + indicesOf(4, names)
+            + indicesOf(2, { u"s1"_s, u"s2"_s, u"s3"_s });
+    std::sort(all.begin(), all.end());
+    QCOMPARE(all, QList<qsizetype>({ 0, 1, 2, 3, 4, 5, 6 }));
+
+    QCOMPARE(processor.updateMessageDescriptions({}), 3);
+    QVERIFY(processor.messageDescriptions().isEmpty());
+}
+
+void tst_QCanFrameProcessor::decodeFrames()
+{
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setSource(QtCanBus::DataSource::FrameId);
+    uidDesc.setEndian(QSysInfo::Endian::LittleEndian);
+    uidDesc.setStartBit(0);
+    uidDesc.setBitLength(11);
+
+    QCanSignalDescription muxSignal;
+    muxSignal.setName(u"mux"_s);
+    muxSignal.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+    muxSignal.setDataEndian(QSysInfo::Endian::LittleEndian);
+    muxSignal.setStartBit(0);
+    muxSignal.setBitLength(8);
+    muxSignal.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
+
+    QCanSignalDescription valueSignal;
+    valueSignal.setName(u"value"_s);
+    valueSignal.setDataFormat(QtCanBus::DataFormat::SignedInteger);
+    valueSignal.setDataEndian(QSysInfo::Endian::BigEndian);
+    valueSignal.setStartBit(15);
+    valueSignal.setBitLength(16);
+    valueSignal.setFactor(0.5);
+    valueSignal.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    valueSignal.addMultiplexSignal(muxSignal.name(), 1);
+
+    // does not fit into the frame, generates a warning
+    QCanSignalDescription tooLongSignal;
+    tooLongSignal.setName(u"tooLong"_s);
+    tooLongSignal.setDataFormat(QtCanBus::DataFormat::UnsignedInteger);
+    tooLongSignal.setDataSource(QtCanBus::DataSource::FrameId);
+    tooLongSignal.setStartBit(4);
+    tooLongSignal.setBitLength(12);
+
+    QCanMessageDescription message;
+    message.setName(u"test"_s);
+    message.setUniqueId(QtCanBus::UniqueId{0x10});
+    message.setSize(3);
+    message.setSignalDescriptions({ muxSignal, valueSignal, tooLongSignal });
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    processor.setMessageDescriptions({ message });
+
+    // Several chunks of valid frames, mixed with frames that fail
+    QList<QCanBusFrame> frames;
+    for (int i = 0; i < 5000; ++i) {
+        const char payload[] = { char(i % 3), char(i >> 8), char(i) };
+        switch (i % 7) {
+        case 0: // unknown unique id
+            frames.append(QCanBusFrame(0x11, QByteArray(payload, 3)));
+            break;
+        case 1: // wrong payload size
+            frames.append(QCanBusFrame(0x10, QByteArray(payload, 2)));
+            break;
+        default:
+            frames.append(QCanBusFrame(0x10, QByteArray(payload, 3)));
+            break;
+        }
+    }
+
+    // The processor state is not touched
+    QVERIFY(processor.parseFrame(frames.at(0)).signalValues.isEmpty());
+    const QString expectedErrorString = processor.errorString();
+
+    const auto results = processor.decodeFrames(frames);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Decoding);
+    QCOMPARE(processor.errorString(), expectedErrorString);
+
+    QCOMPARE(results.size(), frames.size());
+    for (qsizetype i = 0; i < frames.size(); ++i) {
+        const auto expected = processor.parseFrame(frames.at(i));
+        const auto &result = results.at(i);
+        QCOMPARE(result.uniqueId, expected.uniqueId);
+        QCOMPARE(result.signalValues, expected.signalValues);
+        QCOMPARE(result.error, processor.error());
+        QCOMPARE(result.errorString, processor.errorString());
+        QCOMPARE(result.warnings, processor.warnings());
+
+        const auto single = processor.decodeFrame(frames.at(i));
+        QCOMPARE(single.signalValues, result.signalValues);
+        QCOMPARE(single.error, result.error);
+    }
+    QVERIFY(results.at(2).signalValues.contains(u"mux"_s));
+    QCOMPARE(results.at(2).warnings.size(), 1);
+    QCOMPARE(results.at(0).error, QCanFrameProcessor::Error::Decoding);
+
+    QVERIFY(processor.decodeFrames({}).isEmpty());
+}
+
+void tst_QCanFrameProcessor::prepareFrameFromValues()
+{
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setSource(QtCanBus::DataSource::FrameId);
+    uidDesc.setEndian(QSysInfo::Endian::LittleEndian);
+    uidDesc.setStartBit(0);
+    uidDesc.setBitLength(11);
+
+    auto makeSignal = [](const QString &name, QtCanBus::DataFormat format,
+                         QSysInfo::Endian endian, quint16 startBit, quint16 bitLength) {
+        QCanSignalDescription sig;
+        sig.setName(name);
+        sig.setDataFormat(format);
+        sig.setDataEndian(endian);
+        sig.setStartBit(startBit);
+        sig.setBitLength(bitLength);
+        return sig;
+    };
+    using Format = QtCanBus::DataFormat;
+    constexpr auto LE = QSysInfo::Endian::LittleEndian;
+    constexpr auto BE = QSysInfo::Endian::BigEndian;
+
+    QCanSignalDescription mux = makeSignal(u"mux"_s, Format::UnsignedInteger, LE, 0, 4);
+    mux.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
+    QCanSignalDescription speed = makeSignal(u"speed"_s, Format::SignedInteger, LE, 4, 12);
+    speed.setFactor(0.1);
+    speed.setOffset(-10);
+    QCanSignalDescription temperature =
+            makeSignal(u"temperature"_s, Format::SignedInteger, BE, 23, 12);
+    QCanSignalDescription low = makeSignal(u"low"_s, Format::UnsignedInteger, LE, 32, 8);
+    low.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    low.addMultiplexSignal(mux.name(), 1);
+    QCanSignalDescription high = makeSignal(u"high"_s, Format::Float, LE, 32, 32);
+    high.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    high.addMultiplexSignal(mux.name(), 2);
+
+    QCanMessageDescription message;
+    message.setName(u"test"_s);
+    message.setUniqueId(QtCanBus::UniqueId{0x123});
+    message.setSize(8);
+    message.setSignalDescriptions({ mux, speed, temperature, low, high });
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    processor.setMessageDescriptions({ message });
+
+    const QtCanBus::UniqueId uid{0x123};
+    QList<double> values(processor.signalIndexCount());
+    auto setValue = [&](const QString &name, double value) {
+        values[processor.signalIndex(uid, name)] = value;
+    };
+    setValue(u"mux"_s, 2);
+    setValue(u"speed"_s, 123.4);
+    setValue(u"temperature"_s, -1000);
+    setValue(u"low"_s, 200);
+    setValue(u"high"_s, 1.5);
+
+    // The result is the same as when passing the values by name. The signal
+    // "low" is not written, because the multiplexor value does not match.
+    const QVariantMap namedValues{ { u"mux"_s, 2 }, { u"speed"_s, 123.4 },
+                                   { u"temperature"_s, -1000 }, { u"high"_s, 1.5 } };
+    const QCanBusFrame expectedFrame = processor.prepareFrame(uid, namedValues);
+    QVERIFY(expectedFrame.isValid());
+
+    QCanBusFrame frame;
+    QCOMPARE(processor.prepareFrame(uid, values, &frame), 4);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+    QCOMPARE(frame.frameId(), expectedFrame.frameId());
+    QCOMPARE(frame.payload(), expectedFrame.payload());
+
+    // Decoding the frame restores the values
+    QList<double> decodedValues(processor.signalIndexCount(), -1);
+    QCOMPARE(processor.parseFrame(frame, decodedValues), 4);
+    QCOMPARE(decodedValues.at(processor.signalIndex(uid, u"mux"_s)), 2);
+    QVERIFY(qFuzzyCompare(decodedValues.at(processor.signalIndex(uid, u"speed"_s)), 123.4));
+    QCOMPARE(decodedValues.at(processor.signalIndex(uid, u"temperature"_s)), -1000);
+    QCOMPARE(decodedValues.at(processor.signalIndex(uid, u"low"_s)), -1);
+    QCOMPARE(decodedValues.at(processor.signalIndex(uid, u"high"_s)), 1.5);
+
+    // The payload of the frame is reused, and all the previous data is cleared
+    const char *payloadData = frame.payloadView().data();
+    setValue(u"mux"_s, 1);
+    QCOMPARE(processor.prepareFrame(uid, values, &frame), 4);
+    QCOMPARE(frame.payloadView().data(), payloadData);
+    QCOMPARE(frame.payload(),
+             processor.prepareFrame(uid, { { u"mux"_s, 1 }, { u"speed"_s, 123.4 },
+                                           { u"temperature"_s, -1000 }, { u"low"_s, 200 } }).
+             payload());
+
+    // Errors do not modify the frame
+    const QCanBusFrame previousFrame = frame;
+    QCOMPARE(processor.prepareFrame(QtCanBus::UniqueId{0x124}, values, &frame), -1);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Encoding);
+    QCOMPARE(processor.prepareFrame(uid, QSpan(values).first(2), &frame), -1);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Encoding);
+    QCOMPARE(frame.frameId(), previousFrame.frameId());
+    QCOMPARE(frame.payload(), previousFrame.payload());
+}
+
+void tst_QCanFrameProcessor::parseColumn()
+{
+    QCanUniqueIdDescription uidDesc;
+    uidDesc.setSource(QtCanBus::DataSource::FrameId);
+    uidDesc.setEndian(QSysInfo::Endian::LittleEndian);
+    uidDesc.setStartBit(0);
+    uidDesc.setBitLength(11);
+
+    auto makeSignal = [](const QString &name, QtCanBus::DataFormat format,
+                         QSysInfo::Endian endian, quint16 startBit, quint16 bitLength) {
+        QCanSignalDescription sig;
+        sig.setName(name);
+        sig.setDataFormat(format);
+        sig.setDataEndian(endian);
+        sig.setStartBit(startBit);
+        sig.setBitLength(bitLength);
+        return sig;
+    };
+    using Format = QtCanBus::DataFormat;
+    constexpr auto LE = QSysInfo::Endian::LittleEndian;
+    constexpr auto BE = QSysInfo::Endian::BigEndian;
+
+    // Covers the vectorized conversion of integers, as well as the generic
+    // decoding of floating point values and integers with more than 52 bits
+    QCanSignalDescription mux = makeSignal(u"mux"_s, Format::UnsignedInteger, LE, 0, 2);
+    mux.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
+    QCanSignalDescription speed = makeSignal(u"speed"_s, Format::SignedInteger, LE, 2, 13);
+    speed.setFactor(0.1);
+    speed.setOffset(-10);
+    QCanSignalDescription temperature =
+            makeSignal(u"temperature"_s, Format::SignedInteger, BE, 23, 12);
+    temperature.setScaling(2);
+    QCanSignalDescription muxed = makeSignal(u"muxed"_s, Format::UnsignedInteger, LE, 24, 4);
+    muxed.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+    muxed.addMultiplexSignal(mux.name(), 1);
+    QCanSignalDescription floatValue = makeSignal(u"float"_s, Format::Float, LE, 32, 32);
+    QCanSignalDescription wide = makeSignal(u"wide"_s, Format::UnsignedInteger, LE, 0, 60);
+
+    QCanMessageDescription message;
+    message.setName(u"test"_s);
+    message.setUniqueId(QtCanBus::UniqueId{0x123});
+    message.setSize(8);
+    message.setSignalDescriptions({ mux, speed, temperature, muxed, floatValue, wide });
+
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uidDesc);
+    processor.setMessageDescriptions({ message });
+
+    // an odd number of frames, so that the tails of the vector loops are used
+    constexpr qsizetype FrameCount = 1001;
+    QByteArray payloads(FrameCount * 8, Qt::Uninitialized);
+    QRandomGenerator random(123);
+    for (char &c : payloads)
+        c = char(random.bounded(256));
+
+    const QtCanBus::UniqueId uid{0x123};
+    QList<double> values(FrameCount);
+    QList<double> frameValues(processor.signalIndexCount());
+    for (const QString &name : { u"mux"_s, u"speed"_s, u"temperature"_s, u"muxed"_s,
+                                 u"float"_s, u"wide"_s }) {
+        const qsizetype index = processor.signalIndex(uid, name);
+        QCOMPARE(processor.parseColumn(uid, index, payloads, values), FrameCount);
+        QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+        for (qsizetype i = 0; i < FrameCount; ++i) {
+            const QCanBusFrame frame(0x123, payloads.sliced(i * 8, 8));
+            frameValues.fill(qQNaN());
+            QVERIFY(processor.parseFrame(frame, frameValues) > 0);
+            const double expected = frameValues.at(index);
+            if (qIsNaN(expected))
+                QVERIFY2(qIsNaN(values.at(i)), qPrintable(name));
+            else
+                QCOMPARE(values.at(i), expected);
+        }
+    }
+
+    // the multiplexed signal is only decoded from the frames in which the mux is 1
+    {
+        constexpr qsizetype MuxFrameCount = 64;
+        QByteArray muxPayloads(MuxFrameCount * 8, 0);
+        for (qsizetype i = 0; i < MuxFrameCount; ++i) {
+            muxPayloads[i * 8] = char(i % 4);
+            muxPayloads[i * 8 + 3] = char(i % 16);
+        }
+        const qsizetype muxedIndex = processor.signalIndex(uid, u"muxed"_s);
+        QCOMPARE(processor.parseColumn(uid, muxedIndex, muxPayloads, values), MuxFrameCount);
+        QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+        for (qsizetype i = 0; i < MuxFrameCount; ++i) {
+            if (i % 4 == 1)
+                QCOMPARE(values.at(i), double(i % 16));
+            else
+                QVERIFY(qIsNaN(values.at(i)));
+        }
+    }
+
+    // errors
+    const qsizetype speedIndex = processor.signalIndex(uid, u"speed"_s);
+    QCOMPARE(processor.parseColumn(QtCanBus::UniqueId{0x124}, speedIndex, payloads, values),
+             -1);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Decoding);
+    QCOMPARE(processor.parseColumn(uid, processor.signalIndexCount(), payloads, values), -1);
+    QCOMPARE(processor.parseColumn(uid, speedIndex, QByteArrayView(payloads).chopped(1),
+                                   values), -1);
+    QCOMPARE(processor.parseColumn(uid, speedIndex, payloads,
+                                   QSpan(values).first(FrameCount - 1)), -1);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::Decoding);
+
+    QCOMPARE(processor.parseColumn(uid, speedIndex, {}, values), 0);
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+}
+
 void tst_QCanFrameProcessor::prepareFrame_data()
 {
     QTest::addColumn<quint16>("startBit");
@@ -1410,6 +2064,31 @@ void tst_QCanFrameProcessor::prepareFrame()
     QVERIFY(frame.isValid());
     QCOMPARE(frame.frameId(), expectedFrame.frameId());
     QCOMPARE(frame.payload(), expectedFrame.payload());
+
+    // The same value, passed by signal index
+    QCanBusFrame indexedFrame;
+    const QtCanBus::UniqueId uid{uniqueId};
+    switch (format) {
+    case QtCanBus::DataFormat::Float:
+    case QtCanBus::DataFormat::Double: {
+        const double values[] = { signalValue.toDouble() };
+        QCOMPARE(processor.prepareFrame(uid, QSpan(values), &indexedFrame), 1);
+        break;
+    }
+    case QtCanBus::DataFormat::SignedInteger: {
+        const qint64 values[] = { signalValue.toLongLong() };
+        QCOMPARE(processor.prepareFrame(uid, QSpan(values), &indexedFrame), 1);
+        break;
+    }
+    default: {
+        const qint64 values[] = { qint64(signalValue.toULongLong()) };
+        QCOMPARE(processor.prepareFrame(uid, QSpan(values), &indexedFrame), 1);
+        break;
+    }
+    }
+    QVERIFY(indexedFrame.isValid());
+    QCOMPARE(indexedFrame.frameId(), expectedFrame.frameId());
+    QCOMPARE(indexedFrame.payload(), expectedFrame.payload());
 }
 
 void tst_QCanFrameProcessor::prepareWithValueConversion_data()
@@ -3,8 +3,34 @@
 
 #include <private/qmodbusadu_p.h>
 
+#include <QtCore/qrandom.h>
 #include <QtTest/QtTest>
 
+// Bit-by-bit reference implementation (pycrc v0.8.3, https://pycrc.org)
+// Width = 16, Poly = 0x8005, XorIn = 0xffff, ReflectIn = True,
+// XorOut = 0x0000, ReflectOut = True, Algorithm = bit-by-bit-fast
+static quint16 referenceCRC(const char *data, qint32 len)
+{
+    quint16 crc = 0xFFFF;
+    while (len--) {
+        const quint8 c = *data++;
+        for (qint32 i = 0x01; i & 0xFF; i <<= 1) {
+            bool bit = crc & 0x8000;
+            if (c & i)
+                bit = !bit;
+            crc <<= 1;
+            if (bit)
+                crc ^= 0x8005;
+        }
+    }
+    quint16 reflected = crc & 0x01;
+    for (qint32 i = 1; i < 16; i++) {
+        crc >>= 1;
+        reflected = (reflected << 1) | (crc & 0x01);
+    }
+    return (reflected >> 8) | (reflected << 8); // swap bytes
+}
+
 class tst_QModbusAdu : public QObject
 {
     Q_OBJECT
@@ -182,6 +208,170 @@ private slots:
         QFETCH(quint16, crc);
         QCOMPARE(QModbusSerialAdu::calculateCRC(pdu.constData(), pdu.size()), crc);
     }
+
+    void testChecksumCRCMatchesReference()
+    {
+        char buffer[260];
+        QCOMPARE(QModbusSerialAdu::calculateCRC(buffer, 0), referenceCRC(buffer, 0));
+
+        // all one and two byte inputs
+        for (int i = 0; i < 0x10000; ++i) {
+            buffer[0] = char(i & 0xFF);
+            buffer[1] = char(i >> 8);
+            if (i < 0x100)
+                QCOMPARE(QModbusSerialAdu::calculateCRC(buffer, 1), referenceCRC(buffer, 1));
+            QCOMPARE(QModbusSerialAdu::calculateCRC(buffer, 2), referenceCRC(buffer, 2));
+        }
+
+        // random data of every valid ADU length, at different alignments
+        QRandomGenerator generator(0x8005);
+        for (qint32 length = 3; length <= 256; ++length) {
+            for (qint32 offset = 0; offset < 4; ++offset) {
+                for (qint32 i = 0; i < length; ++i)
+                    buffer[offset + i] = char(generator.bounded(256));
+                QCOMPARE(QModbusSerialAdu::calculateCRC(buffer + offset, length),
+                         referenceCRC(buffer + offset, length));
+            }
+        }
+    }
+
+    void testTcpAduHeader()
+    {
+        const QByteArray raw = QByteArray::fromHex("12340000000611");
+        const QModbusTcpAdu::Header header = QModbusTcpAdu::readHeader(raw.constData());
+        QCOMPARE(header.transactionId, quint16(0x1234));
+        QCOMPARE(header.protocolId, quint16(0x0000));
+        QCOMPARE(header.length, quint16(0x0006));
+        QCOMPARE(header.unitId, quint8(0x11));
+
+        QByteArray written(QModbusTcpAdu::HeaderSize, Qt::Uninitialized);
+        QModbusTcpAdu::writeHeader(header, written.data());
+        QCOMPARE(written, raw);
+    }
+
+    void testTcpAduCreate()
+    {
+        QModbusTcpAdu::Header header;
+        header.transactionId = 0xbeef;
+        header.unitId = 0x11;
+
+        const QModbusRequest request(QModbusRequest::ReadHoldingRegisters, quint16(0x006b),
+                                     quint16(0x0003));
+        QByteArray expected;
+        QDataStream output(&expected, QIODevice::WriteOnly);
+        output << quint16(0xbeef) << quint16(0) << quint16(request.size() + 1) << quint8(0x11)
+               << request;
+        QCOMPARE(QModbusTcpAdu::create(header, request), expected);
+        QCOMPARE(QModbusTcpAdu::create(header, request),
+                 QByteArray::fromHex("beef0000000611" "03006b0003"));
+
+        const QModbusExceptionResponse exception(QModbusPdu::ReadHoldingRegisters,
+                                                 QModbusExceptionResponse::IllegalDataAddress);
+        QCOMPARE(QModbusTcpAdu::create(header, exception),
+                 QByteArray::fromHex("beef0000000311" "8302"));
+
+        QCOMPARE(QModbusTcpAdu::create(header, QModbusResponse(QModbusPdu::ReadExceptionStatus)),
+                 QByteArray::fromHex("beef0000000211" "07"));
+    }
+
+    void testTcpAduPduFromBuffer()
+    {
+        QByteArray buffer = QByteArray::fromHex("0001000000061103006b0003"
+                                                "000200000006110300010001");
+        const qsizetype second = 12;
+
+        // the first PDU is followed by more data and gets copied
+        const QModbusRequest first = QModbusTcpAdu::pduFromBuffer<QModbusRequest>(buffer,
+            QModbusTcpAdu::HeaderSize, 5);
+        QCOMPARE(first.functionCode(), QModbusPdu::ReadHoldingRegisters);
+        QCOMPARE(first.data(), QByteArray::fromHex("006b0003"));
+        QVERIFY(first.data().constData() != buffer.constData() + QModbusTcpAdu::HeaderSize + 1);
+
+        // the last PDU shares the storage of the buffer
+        const QModbusRequest last = QModbusTcpAdu::pduFromBuffer<QModbusRequest>(buffer,
+            second + QModbusTcpAdu::HeaderSize, 5);
+        QCOMPARE(last.functionCode(), QModbusPdu::ReadHoldingRegisters);
+        QCOMPARE(last.data(), QByteArray::fromHex("00010001"));
+        QVERIFY(last.data().constData()
+                == buffer.constData() + second + QModbusTcpAdu::HeaderSize + 1);
+        QCOMPARE(*(last.data().constData() + last.dataSize()), '\0');
+
+        // removing the consumed bytes must not change the PDU
+        buffer.remove(0, buffer.size());
+        QVERIFY(buffer.isEmpty());
+        QCOMPARE(last.data(), QByteArray::fromHex("00010001"));
+
+        QByteArray exceptionBuffer = QByteArray::fromHex("0003000000031183" "02");
+        const QModbusResponse response = QModbusTcpAdu::pduFromBuffer<QModbusResponse>(
+            exceptionBuffer, QModbusTcpAdu::HeaderSize, 2);
+        QVERIFY(response.isException());
+        QCOMPARE(response.functionCode(), QModbusPdu::ReadHoldingRegisters);
+        QCOMPARE(response.exceptionCode(), QModbusPdu::IllegalDataAddress);
+
+        QByteArray functionCodeOnly = QByteArray::fromHex("00040000000211" "07");
+        const QModbusRequest empty = QModbusTcpAdu::pduFromBuffer<QModbusRequest>(
+            functionCodeOnly, QModbusTcpAdu::HeaderSize, 1);
+        QCOMPARE(empty.functionCode(), QModbusPdu::ReadExceptionStatus);
+        QVERIFY(empty.data().isEmpty());
+    }
+
+    void testReceiveBuffer()
+    {
+        QModbusReceiveBuffer buffer;
+        QVERIFY(buffer.isEmpty());
+
+        buffer.append(QByteArray("0123456789"));
+        QCOMPARE(buffer.size(), qsizetype(10));
+        QCOMPARE(buffer.left(3), QByteArray("012"));
+
+        buffer.consume(3);
+        QCOMPARE(buffer.size(), qsizetype(7));
+        QCOMPARE(buffer.rawData(), QByteArray("3456789"));
+        QCOMPARE(*buffer.constData(), '3');
+
+        // appending keeps the unread bytes, whether or not the read ones are compacted away
+        buffer.append(QByteArray("ab"));
+        QCOMPARE(buffer.rawData(), QByteArray("3456789ab"));
+        buffer.consume(6);
+        QCOMPARE(buffer.rawData(), QByteArray("9ab"));
+        buffer.append(QByteArray("cd"));
+        QCOMPARE(buffer.rawData(), QByteArray("9abcd"));
+
+        // reading everything releases the storage, so new data is adopted without copying
+        buffer.consume(buffer.size());
+        QVERIFY(buffer.isEmpty());
+        const QByteArray data = QByteArray::fromHex("000100000003110700");
+        buffer.append(data);
+        QVERIFY(buffer.constData() == data.constData());
+
+        buffer.consume(1);
+        buffer.clear();
+        QVERIFY(buffer.isEmpty());
+        QCOMPARE(buffer.rawData(), QByteArray());
+    }
+
+    void testReceiveBufferPdu()
+    {
+        QModbusReceiveBuffer buffer;
+        buffer.append(QByteArray::fromHex("0001000000061103006b0003"
+                                          "000200000006110300010001"));
+
+        QModbusTcpAdu::Header header = QModbusTcpAdu::readHeader(buffer.constData());
+        QCOMPARE(header.transactionId, quint16(1));
+        const QModbusRequest first = buffer.pdu<QModbusRequest>(QModbusTcpAdu::HeaderSize,
+                                                                header.length - 1);
+        QCOMPARE(first.data(), QByteArray::fromHex("006b0003"));
+        buffer.consume(QModbusTcpAdu::HeaderSize + header.length - 1);
+
+        header = QModbusTcpAdu::readHeader(buffer.constData());
+        QCOMPARE(header.transactionId, quint16(2));
+        const QModbusRequest last = buffer.pdu<QModbusRequest>(QModbusTcpAdu::HeaderSize,
+                                                               header.length - 1);
+        QVERIFY(last.data().constData() == buffer.constData() + QModbusTcpAdu::HeaderSize + 1);
+        buffer.consume(QModbusTcpAdu::HeaderSize + header.length - 1);
+        QVERIFY(buffer.isEmpty());
+        QCOMPARE(last.data(), QByteArray::fromHex("00010001"));
+    }
 };
 
 QTEST_MAIN(tst_QModbusAdu)
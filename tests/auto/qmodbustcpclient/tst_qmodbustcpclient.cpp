@@ -0,0 +1,217 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qmodbustcpclient.h>
+
+#include <private/qmodbusadu_p.h>
+
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/QtTest>
+
+using namespace Qt::StringLiterals;
+
+// A Modbus TCP peer that records the requests it receives and only answers on demand
+class FakeServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Request
+    {
+        QModbusTcpAdu::Header header;
+        QModbusRequest pdu;
+    };
+
+    FakeServer()
+    {
+        connect(&server, &QTcpServer::newConnection, this, [this]() {
+            socket = server.nextPendingConnection();
+            connect(socket, &QTcpSocket::readyRead, this, [this]() {
+                buffer.append(socket->readAll());
+                while (buffer.size() >= QModbusTcpAdu::HeaderSize) {
+                    const QModbusTcpAdu::Header header
+                        = QModbusTcpAdu::readHeader(buffer.constData());
+                    const qsizetype pduSize = header.length - 1;
+                    if (buffer.size() < QModbusTcpAdu::HeaderSize + pduSize)
+                        break;
+                    requests.append({ header, buffer.pdu<QModbusRequest>(
+                                                  QModbusTcpAdu::HeaderSize, pduSize) });
+                    buffer.consume(QModbusTcpAdu::HeaderSize + pduSize);
+                }
+            });
+        });
+    }
+
+    bool listen() { return server.listen(QHostAddress::LocalHost); }
+    quint16 port() const { return server.serverPort(); }
+
+    // Answers a read holding registers request with the requested start address as value.
+    void answer(const Request &request)
+    {
+        quint16 address = 0;
+        request.pdu.decodeData(&address);
+        const QModbusResponse response(QModbusResponse::ReadHoldingRegisters, quint8(2), address);
+        socket->write(QModbusTcpAdu::create(request.header, response));
+    }
+
+    QTcpServer server;
+    QTcpSocket *socket = nullptr;
+    QModbusReceiveBuffer buffer;
+    QList<Request> requests;
+};
+
+class tst_QModbusTcpClient : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void manyRequestsInFlight();
+    void retriesAndTimeout();
+    void deletedReplyIsNotResent();
+    void changedTimeoutRestartsPendingTimeouts();
+
+private:
+    QModbusReply *sendRead(quint16 address);
+
+    std::unique_ptr<FakeServer> server;
+    std::unique_ptr<QModbusTcpClient> client;
+
+    static constexpr int ServerAddress = 1;
+};
+
+void tst_QModbusTcpClient::init()
+{
+    server = std::make_unique<FakeServer>();
+    QVERIFY(server->listen());
+
+    client = std::make_unique<QModbusTcpClient>();
+    client->setConnectionParameter(QModbusDevice::NetworkAddressParameter, u"127.0.0.1"_s);
+    client->setConnectionParameter(QModbusDevice::NetworkPortParameter, server->port());
+    QVERIFY(client->connectDevice());
+    QTRY_COMPARE(client->state(), QModbusDevice::ConnectedState);
+    QTRY_VERIFY(server->socket);
+}
+
+void tst_QModbusTcpClient::cleanup()
+{
+    client.reset();
+    server.reset();
+}
+
+QModbusReply *tst_QModbusTcpClient::sendRead(quint16 address)
+{
+    return client->sendReadRequest({ QModbusDataUnit::HoldingRegisters, address, 1 },
+                                   ServerAddress);
+}
+
+// More transactions than the initial size of the transaction table, answered out of order
+void tst_QModbusTcpClient::manyRequestsInFlight()
+{
+    constexpr int RequestCount = 300;
+
+    QList<QModbusReply *> replies;
+    for (int i = 0; i < RequestCount; ++i) {
+        QModbusReply *reply = sendRead(quint16(i));
+        QVERIFY(reply);
+        replies.append(reply);
+    }
+    QTRY_COMPARE(server->requests.size(), RequestCount);
+
+    for (qsizetype i = server->requests.size() - 1; i >= 0; --i)
+        server->answer(server->requests.at(i));
+
+    for (int i = 0; i < RequestCount; ++i) {
+        QModbusReply *reply = replies.at(i);
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QModbusDevice::NoError);
+        QCOMPARE(reply->result().value(0), quint16(i));
+        delete reply;
+    }
+}
+
+void tst_QModbusTcpClient::retriesAndTimeout()
+{
+    client->setTimeout(50);
+    client->setNumberOfRetries(2);
+
+    QModbusReply *reply = sendRead(7);
+    QVERIFY(reply);
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QModbusDevice::TimeoutError);
+
+    // the initial request and two retries, all with the same transaction id
+    QTRY_COMPARE(server->requests.size(), 3);
+    for (const FakeServer::Request &request : std::as_const(server->requests)) {
+        QCOMPARE(request.header.transactionId, server->requests.first().header.transactionId);
+        QCOMPARE(request.pdu.functionCode(), QModbusPdu::ReadHoldingRegisters);
+        QCOMPARE(request.pdu.data(), server->requests.first().pdu.data());
+    }
+
+    // a response after a retry is still accepted; there are enough retries left that the
+    // reply cannot time out before the answer arrives, even on a loaded machine
+    server->requests.clear();
+    client->setTimeout(200);
+    client->setNumberOfRetries(100);
+    QModbusReply *answered = sendRead(8);
+    QTRY_VERIFY(server->requests.size() >= 2);
+    const quint16 answeredId = server->requests.first().header.transactionId;
+    server->answer(server->requests.last());
+    QTRY_VERIFY(answered->isFinished());
+    QCOMPARE(answered->error(), QModbusDevice::NoError);
+    QCOMPARE(answered->result().value(0), quint16(8));
+
+    // No further retries once answered. Retries sent before the answer was processed may
+    // still be on their way, so wait for a later request to arrive first; TCP keeps the order.
+    QModbusReply *marker = sendRead(9);
+    QVERIFY(marker);
+    delete marker;
+    QTRY_VERIFY(server->requests.last().header.transactionId != answeredId);
+    const qsizetype requestCount = server->requests.size();
+    QTest::qWait(5 * client->timeout());
+    QCOMPARE(server->requests.size(), requestCount);
+
+    delete reply;
+    delete answered;
+}
+
+void tst_QModbusTcpClient::deletedReplyIsNotResent()
+{
+    client->setTimeout(50);
+    client->setNumberOfRetries(3);
+
+    // The request is written right away, deleting the reply before returning to the event
+    // loop makes sure that no timeout has expired yet, however slow the machine is.
+    QModbusReply *reply = sendRead(1);
+    QVERIFY(reply);
+    delete reply;
+    QTRY_COMPARE(server->requests.size(), 1);
+
+    // longer than all retries together
+    QTest::qWait(10 * client->timeout());
+    QCOMPARE(server->requests.size(), 1);
+}
+
+void tst_QModbusTcpClient::changedTimeoutRestartsPendingTimeouts()
+{
+    client->setTimeout(60000);
+    client->setNumberOfRetries(0);
+
+    QModbusReply *reply = sendRead(1);
+    QVERIFY(reply);
+    QTRY_COMPARE(server->requests.size(), 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    client->setTimeout(50);
+    QTRY_VERIFY(reply->isFinished());
+    QVERIFY(timer.elapsed() < 5000);
+    QCOMPARE(reply->error(), QModbusDevice::TimeoutError);
+    delete reply;
+}
+
+QTEST_MAIN(tst_QModbusTcpClient)
+
+#include "tst_qmodbustcpclient.moc"
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qmodbustcpserver.h>
+
+#include <private/qmodbusadu_p.h>
+#include <private/qmodbustcpserver_p.h>
+
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/QtTest>
+
+using namespace Qt::StringLiterals;
+
+class tst_QModbusTcpServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void pipelinedRequests();
+    void splitRequest();
+
+private:
+    QByteArray readRequest(quint16 transactionId, quint16 address) const;
+    void verifyResponses(const QByteArray &responses, int count) const;
+
+    std::unique_ptr<QModbusTcpServer> server;
+    quint16 port = 0;
+
+    static constexpr int ServerAddress = 1;
+    static constexpr int RegisterCount = 16;
+    // MBAP header, function code, byte count and the values of two registers
+    static constexpr qsizetype ResponseSize = QModbusTcpAdu::HeaderSize + 2 + 4;
+};
+
+void tst_QModbusTcpServer::init()
+{
+    server = std::make_unique<QModbusTcpServer>();
+
+    QModbusDataUnit registers(QModbusDataUnit::HoldingRegisters, 0, RegisterCount);
+    for (int i = 0; i < RegisterCount; ++i)
+        registers.setValue(i, quint16(0x1000 + i));
+    QModbusDataUnitMap map;
+    map.insert(QModbusDataUnit::HoldingRegisters, registers);
+    QVERIFY(server->setMap(map));
+
+    server->setServerAddress(ServerAddress);
+    server->setConnectionParameter(QModbusDevice::NetworkAddressParameter, u"127.0.0.1"_s);
+    server->setConnectionParameter(QModbusDevice::NetworkPortParameter, 0);
+    QVERIFY2(server->connectDevice(), qPrintable(server->errorString()));
+
+    auto *d = static_cast<QModbusTcpServerPrivate *>(QObjectPrivate::get(server.get()));
+    port = d->m_tcpServer->serverPort();
+    QVERIFY(port != 0);
+}
+
+void tst_QModbusTcpServer::cleanup()
+{
+    server.reset();
+}
+
+QByteArray tst_QModbusTcpServer::readRequest(quint16 transactionId, quint16 address) const
+{
+    QModbusTcpAdu::Header header;
+    header.transactionId = transactionId;
+    header.unitId = ServerAddress;
+    return QModbusTcpAdu::create(header, QModbusRequest(QModbusRequest::ReadHoldingRegisters,
+                                                        address, quint16(2)));
+}
+
+void tst_QModbusTcpServer::verifyResponses(const QByteArray &responses, int count) const
+{
+    QCOMPARE(responses.size(), count * ResponseSize);
+    for (int i = 0; i < count; ++i) {
+        const char *response = responses.constData() + i * ResponseSize;
+        const QModbusTcpAdu::Header header = QModbusTcpAdu::readHeader(response);
+        QCOMPARE(header.transactionId, quint16(i));
+        QCOMPARE(header.length, quint16(ResponseSize - QModbusTcpAdu::HeaderSize + 1));
+        QCOMPARE(header.unitId, quint8(ServerAddress));
+
+        const quint16 address = quint16(i % (RegisterCount - 1));
+        const QByteArray pdu(response + QModbusTcpAdu::HeaderSize,
+                             ResponseSize - QModbusTcpAdu::HeaderSize);
+        QModbusResponse expected(QModbusResponse::ReadHoldingRegisters, quint8(4),
+                                 quint16(0x1000 + address), quint16(0x1000 + address + 1));
+        QCOMPARE(pdu, QModbusTcpAdu::create({}, expected).mid(QModbusTcpAdu::HeaderSize));
+    }
+}
+
+// Many requests arriving in one read must all be answered, in order.
+void tst_QModbusTcpServer::pipelinedRequests()
+{
+    constexpr int RequestCount = 10000;
+
+    QByteArray requests;
+    for (int i = 0; i < RequestCount; ++i)
+        requests += readRequest(quint16(i), quint16(i % (RegisterCount - 1)));
+
+    QTcpSocket socket;
+    QByteArray responses;
+    connect(&socket, &QTcpSocket::readyRead, this, [&]() { responses += socket.readAll(); });
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    QTRY_COMPARE(socket.state(), QAbstractSocket::ConnectedState);
+
+    QCOMPARE(socket.write(requests), requests.size());
+    QTRY_COMPARE_WITH_TIMEOUT(responses.size(), RequestCount * ResponseSize, 30000);
+    verifyResponses(responses, RequestCount);
+}
+
+// Requests split at arbitrary positions must be reassembled.
+void tst_QModbusTcpServer::splitRequest()
+{
+    constexpr int RequestCount = 3;
+
+    QByteArray requests;
+    for (int i = 0; i < RequestCount; ++i)
+        requests += readRequest(quint16(i), quint16(i));
+
+    QTcpSocket socket;
+    QByteArray responses;
+    connect(&socket, &QTcpSocket::readyRead, this, [&]() { responses += socket.readAll(); });
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    QTRY_COMPARE(socket.state(), QAbstractSocket::ConnectedState);
+
+    // the header of the first request, then the rest of it together with half the second one
+    const qsizetype requestSize = requests.size() / RequestCount;
+    const qsizetype splits[] = { 0, 4, requestSize + requestSize / 2, requests.size() };
+    // complete requests are answered right away, even if followed by an incomplete one
+    const int answered[] = { 0, 0, 1, RequestCount };
+    for (qsizetype i = 1; i < qsizetype(std::size(splits)); ++i) {
+        socket.write(requests.mid(splits[i - 1], splits[i] - splits[i - 1]));
+        QVERIFY(socket.waitForBytesWritten());
+        if (answered[i] > 0)
+            QTRY_COMPARE(responses.size(), answered[i] * ResponseSize);
+        else
+            QTest::qWait(50);
+        QCOMPARE(responses.size(), answered[i] * ResponseSize);
+    }
+
+    verifyResponses(responses, RequestCount);
+}
+
+QTEST_MAIN(tst_QModbusTcpServer)
+
+#include "tst_qmodbustcpserver.moc"
@@ -0,0 +1,238 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qcanbus.h>
+#include <QtSerialBus/qcanbusdevice.h>
+#include <QtSerialBus/qcanbusframe.h>
+
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+// The test needs a virtual CAN interface, which can be set up with:
+//     sudo modprobe vcan
+//     sudo ip link add dev vcan0 type vcan
+//     sudo ip link set up vcan0
+// The interface name can be changed with the environment variable QT_TEST_SOCKETCAN_DEVICE.
+
+class tst_SocketCan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void writeFrames();
+    void writeFramesInvalidFrame();
+    void clearOutput();
+    void writeAfterReconnect();
+    void unsupportedFilterIsRejected();
+    void disconnectWhileReceiveThreadBlocks();
+
+private:
+    std::unique_ptr<QCanBusDevice> createDevice() const;
+    static QList<QCanBusFrame> createFrames(int count);
+
+    QString interfaceName;
+};
+
+std::unique_ptr<QCanBusDevice> tst_SocketCan::createDevice() const
+{
+    std::unique_ptr<QCanBusDevice> device(
+                QCanBus::instance()->createDevice(u"socketcan"_s, interfaceName));
+    return device;
+}
+
+QList<QCanBusFrame> tst_SocketCan::createFrames(int count)
+{
+    QList<QCanBusFrame> frames;
+    frames.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const quint32 id = quint32(i % 0x800);
+        frames.append(QCanBusFrame(id, QByteArray::number(i)));
+    }
+    return frames;
+}
+
+void tst_SocketCan::initTestCase()
+{
+    interfaceName = qEnvironmentVariable("QT_TEST_SOCKETCAN_DEVICE", u"vcan0"_s);
+
+    if (!QCanBus::instance()->plugins().contains(u"socketcan"_s))
+        QSKIP("The SocketCAN plugin is not available.");
+
+    std::unique_ptr<QCanBusDevice> device = createDevice();
+    if (!device || !device->connectDevice())
+        QSKIP(qPrintable(u"The CAN interface %1 is not available."_s.arg(interfaceName)));
+}
+
+void tst_SocketCan::writeFrames()
+{
+    // more frames than fit into a single sendmmsg() call
+    constexpr int frameCount = 500;
+
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(sender && receiver);
+    QVERIFY(sender->connectDevice());
+    QVERIFY(receiver->connectDevice());
+
+    qint64 written = 0;
+    connect(sender.get(), &QCanBusDevice::framesWritten, this,
+            [&written](qint64 count) { written += count; });
+    QList<QCanBusFrame> received;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this,
+            [&]() { received += receiver->readAllFrames(); });
+
+    const QList<QCanBusFrame> frames = createFrames(frameCount);
+    QCOMPARE(sender->writeFrames(frames), frameCount);
+
+    QTRY_COMPARE(written, frameCount);
+    QCOMPARE(sender->framesToWrite(), 0);
+    QTRY_COMPARE(received.size(), frameCount);
+    for (int i = 0; i < frameCount; ++i) {
+        QCOMPARE(received.at(i).frameId(), frames.at(i).frameId());
+        QCOMPARE(received.at(i).payload(), frames.at(i).payload());
+    }
+}
+
+void tst_SocketCan::writeFramesInvalidFrame()
+{
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(sender && receiver);
+    QVERIFY(sender->connectDevice());
+    QVERIFY(receiver->connectDevice());
+
+    QList<QCanBusFrame> received;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this,
+            [&]() { received += receiver->readAllFrames(); });
+
+    QList<QCanBusFrame> frames = createFrames(3);
+    frames.insert(2, QCanBusFrame(QCanBusFrame::InvalidFrame));
+
+    // writing stops at the invalid frame
+    QCOMPARE(sender->writeFrames(frames), 2);
+    QCOMPARE(sender->error(), QCanBusDevice::WriteError);
+    QTRY_COMPARE(received.size(), 2);
+    QCOMPARE(received.at(1).payload(), frames.at(1).payload());
+}
+
+void tst_SocketCan::clearOutput()
+{
+    constexpr int frameCount = 2000;
+
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    QVERIFY(sender);
+    QVERIFY(sender->connectDevice());
+
+    QSignalSpy writtenSpy(sender.get(), &QCanBusDevice::framesWritten);
+    QCOMPARE(sender->writeFrames(createFrames(frameCount)), frameCount);
+
+    // whatever could not be handed to the kernel yet, including frames prepared
+    // for the next sendmmsg() call, is pending until it is cleared
+    QVERIFY(sender->framesToWrite() <= frameCount);
+    sender->clear(QCanBusDevice::Output);
+    QCOMPARE(sender->framesToWrite(), 0);
+
+    QTest::qWait(100);
+    qint64 written = 0;
+    for (const QList<QVariant> &arguments : std::as_const(writtenSpy))
+        written += arguments.at(0).toLongLong();
+    QVERIFY(written <= frameCount);
+    QCOMPARE(sender->framesToWrite(), 0);
+}
+
+void tst_SocketCan::writeAfterReconnect()
+{
+    constexpr int frameCount = 2000;
+
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(sender && receiver);
+    QVERIFY(sender->connectDevice());
+
+    // frames which are not written yet are dropped when disconnecting
+    QCOMPARE(sender->writeFrames(createFrames(frameCount)), frameCount);
+    sender->disconnectDevice();
+    QTRY_COMPARE(sender->state(), QCanBusDevice::UnconnectedState);
+    QCOMPARE(sender->framesToWrite(), 0);
+
+    QVERIFY(receiver->connectDevice());
+    QList<QCanBusFrame> received;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this,
+            [&]() { received += receiver->readAllFrames(); });
+
+    QVERIFY(sender->connectDevice());
+    const QList<QCanBusFrame> frames = createFrames(3);
+    for (const QCanBusFrame &frame : frames)
+        QVERIFY(sender->writeFrame(frame));
+    QCOMPARE(sender->writeFrames(frames), frames.size());
+
+    QTRY_COMPARE(received.size(), 2 * frames.size());
+    QCOMPARE(sender->framesToWrite(), 0);
+    for (qsizetype i = 0; i < received.size(); ++i)
+        QCOMPARE(received.at(i).payload(), frames.at(i % frames.size()).payload());
+}
+
+void tst_SocketCan::unsupportedFilterIsRejected()
+{
+    std::unique_ptr<QCanBusDevice> device = createDevice();
+    QVERIFY(device);
+    QVERIFY(device->connectDevice());
+
+    // the unsupported filter is covered by the first one, but must not be ignored
+    QCanBusDevice::Filter all;
+    all.frameId = 0;
+    all.frameIdMask = 0;
+    all.type = QCanBusFrame::InvalidFrame;
+    QCanBusDevice::Filter unsupported;
+    unsupported.frameId = 0x123;
+    unsupported.frameIdMask = 0x7ff;
+    unsupported.type = QCanBusFrame::UnknownFrame;
+
+    device->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                      QVariant::fromValue(QList{ all, unsupported }));
+    QCOMPARE(device->error(), QCanBusDevice::ConfigurationError);
+    QVERIFY(!device->configurationParameter(QCanBusDevice::RawFilterKey).isValid());
+}
+
+void tst_SocketCan::disconnectWhileReceiveThreadBlocks()
+{
+    constexpr int queueSize = 4;
+
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(sender && receiver);
+    receiver->setConfigurationParameter(QCanBusDevice::ReceiveQueueSizeKey, queueSize);
+    receiver->setConfigurationParameter(QCanBusDevice::ReceiveQueueOverflowPolicyKey,
+                                        QVariant::fromValue(QCanBusDevice::BlockWhenFull));
+    receiver->setConfigurationParameter(QCanBusDevice::ReceiveThreadKey, true);
+    QVERIFY(sender->connectDevice());
+    QVERIFY(receiver->connectDevice());
+
+    // nothing reads the frames, so the receive thread waits for room in the queue
+    QCOMPARE(sender->writeFrames(createFrames(10 * queueSize)), 10 * queueSize);
+    QTRY_COMPARE(receiver->framesAvailable(), queueSize);
+    QTest::qWait(50);
+
+    // must not wait for the blocked receive thread forever
+    receiver->disconnectDevice();
+    QTRY_COMPARE(receiver->state(), QCanBusDevice::UnconnectedState);
+
+    // the device is still usable afterwards
+    QVERIFY(receiver->connectDevice());
+    receiver->readAllFrames();
+    QList<QCanBusFrame> received;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this,
+            [&]() { received += receiver->readAllFrames(); });
+    QVERIFY(sender->writeFrame(QCanBusFrame(0x123, "after")));
+    QTRY_VERIFY(!received.isEmpty());
+    QCOMPARE(received.last().payload(), QByteArray("after"));
+}
+
+QTEST_MAIN(tst_SocketCan)
+
+#include "tst_socketcan.moc"
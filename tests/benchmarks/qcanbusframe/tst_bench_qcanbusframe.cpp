@@ -0,0 +1,106 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qcanbusframe.h>
+#include <QtSerialBus/private/qcanbusframe_p.h>
+
+#include <QtCore/qset.h>
+#include <QtTest/qtest.h>
+
+class tst_Bench_QCanBusFrame : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data();
+    void construct();
+    void copy();
+    void readPayload();
+    void readPayloadView();
+
+private:
+    static constexpr qsizetype FrameCount = 10000;
+};
+
+void tst_Bench_QCanBusFrame::construct_data()
+{
+    QTest::addColumn<bool>("useArena");
+
+    QTest::newRow("heap") << false;
+    QTest::newRow("arena") << true;
+}
+
+// Mimics a backend's receive path: one frame with a fresh 8 byte payload per CAN message
+void tst_Bench_QCanBusFrame::construct()
+{
+    QFETCH(bool, useArena);
+
+    const char data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    QList<QCanBusFrame> frames;
+    frames.reserve(FrameCount);
+
+    QBENCHMARK {
+        frames.clear();
+        QCanBusFramePayloadArena arena;
+        for (qsizetype i = 0; i < FrameCount; ++i) {
+            QCanBusFrame frame;
+            frame.setFrameId(0x123);
+            frame.setPayload(useArena ? arena.payload(data, sizeof(data))
+                                      : QByteArray(data, sizeof(data)));
+            frames.append(std::move(frame));
+        }
+    }
+
+    // every distinct data block is one heap allocation
+    QSet<const void *> blocks;
+    for (const QCanBusFrame &frame : std::as_const(frames)) {
+        QByteArray payload = frame.payload();
+        blocks.insert(payload.data_ptr().d_ptr());
+    }
+    qDebug("%.4f payload allocations per frame", double(blocks.size()) / double(FrameCount));
+}
+
+void tst_Bench_QCanBusFrame::copy()
+{
+    const QCanBusFrame frame(0x123, QByteArray(8, 'x'));
+    QList<QCanBusFrame> frames;
+    frames.reserve(FrameCount);
+
+    QBENCHMARK {
+        frames.clear();
+        for (qsizetype i = 0; i < FrameCount; ++i)
+            frames.append(frame);
+    }
+}
+
+void tst_Bench_QCanBusFrame::readPayload()
+{
+    const QList<QCanBusFrame> frames(FrameCount, QCanBusFrame(0x123, QByteArray(8, 'x')));
+    quint64 sum = 0;
+
+    QBENCHMARK {
+        for (const QCanBusFrame &frame : frames) {
+            const QByteArray payload = frame.payload();
+            sum += quint8(payload.at(0)) + quint8(payload.at(7));
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_Bench_QCanBusFrame::readPayloadView()
+{
+    const QList<QCanBusFrame> frames(FrameCount, QCanBusFrame(0x123, QByteArray(8, 'x')));
+    quint64 sum = 0;
+
+    QBENCHMARK {
+        for (const QCanBusFrame &frame : frames) {
+            const QByteArrayView payload = frame.payloadView();
+            sum += quint8(payload.at(0)) + quint8(payload.at(7));
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+QTEST_MAIN(tst_Bench_QCanBusFrame)
+
+#include "tst_bench_qcanbusframe.moc"
@@ -0,0 +1,263 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qcandbcfileparser.h>
+#include <QtSerialBus/qcanmessagedescription.h>
+#include <QtSerialBus/qcansignaldescription.h>
+
+#include <QtCore/qset.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtTest/qtest.h>
+
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#endif
+
+using namespace Qt::StringLiterals;
+
+class tst_Bench_QCanDbcFileParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void peakMemory();
+    void stringStorage_data();
+    void stringStorage();
+    void parseData();
+    void parseFile();
+    void parseMultipleFiles();
+    void loadCache();
+
+private:
+    static QString createDbcData(int firstMessage, int messageCount);
+
+    static constexpr int MessageCount = 10000;
+    static constexpr int SignalsPerMessage = 8;
+    // Like a vehicle configuration with one file per bus
+    static constexpr int FileCount = 32;
+
+    QString dbcData;
+    QTemporaryFile dbcFile;
+    QTemporaryDir dbcDir;
+    QStringList dbcFileNames;
+};
+
+// Creates a DBC file similar to the ones provided by vehicle manufacturers,
+// with all the sections that the parser supports.
+QString tst_Bench_QCanDbcFileParser::createDbcData(int firstMessage, int messageCount)
+{
+    QString messages;
+    QString comments;
+    QString valueDescriptions;
+    QString signalTypes;
+    QString extendedMux;
+
+    for (int i = firstMessage; i < firstMessage + messageCount; ++i) {
+        const int id = 0x100 + i;
+        messages += u"BO_ %1 Message_%1 : 8 ECU_%2\n"_s.arg(id).arg(i % 16);
+        // some messages use simple, and some extended multiplexing
+        const bool multiplexed = i % 8 == 0;
+        const bool extendedMultiplexed = i % 8 == 4;
+        for (int j = 0; j < SignalsPerMessage; ++j) {
+            QString mux;
+            if (multiplexed || extendedMultiplexed) {
+                if (j == 0)
+                    mux = u" M"_s;
+                else if (j == 1 && extendedMultiplexed)
+                    mux = u" m1M"_s;
+                else
+                    mux = u" m%1"_s.arg(j % 3);
+            }
+            const bool littleEndian = (i + j) % 3 != 0;
+            const int startBit = littleEndian ? j * 8 : j * 8 + 7;
+            messages += u" SG_ Signal_%1_%2%3 : %4|8@%5%6 (%7,%8) [%9|%10] \"unit\""
+                        " Receiver_1,Receiver_2\n"_s
+                        .arg(i).arg(j).arg(mux).arg(startBit).arg(littleEndian ? 1 : 0)
+                        .arg(j % 2 ? u"-"_s : u"+"_s).arg(0.5 * (j + 1)).arg(-10 * j)
+                        .arg(-128).arg(1000);
+        }
+        messages += u'\n';
+
+        if (i % 4 == 0)
+            comments += u"CM_ BO_ %1 \"Comment for message %1\";\n"_s.arg(id);
+        comments += u"CM_ SG_ %1 Signal_%2_1 \"Comment for signal 1\";\n"_s.arg(id).arg(i);
+        valueDescriptions += u"VAL_ %1 Signal_%2_2 0 \"Off\" 1 \"On\" 2 \"Error\" "
+                             "3 \"Not available\" ;\n"_s.arg(id).arg(i);
+        if (i % 16 == 1)
+            signalTypes += u"SIG_VALTYPE_ %1 Signal_%2_4 : 1;\n"_s.arg(id).arg(i);
+        if (extendedMultiplexed) {
+            extendedMux += u"SG_MUL_VAL_ %1 Signal_%2_1 Signal_%2_0 1-1 ;\n"_s.arg(id).arg(i);
+            for (int j = 2; j < SignalsPerMessage; ++j) {
+                extendedMux += u"SG_MUL_VAL_ %1 Signal_%2_%3 Signal_%2_1 0-3, 5-5 ;\n"_s
+                               .arg(id).arg(i).arg(j);
+            }
+        }
+    }
+
+    return u"VERSION \"\"\n\nNS_ :\n    CM_\n    VAL_\n\nBS_:\n\nBU_: ECU\n\n"_s
+            + messages + comments + valueDescriptions + signalTypes + extendedMux;
+}
+
+void tst_Bench_QCanDbcFileParser::initTestCase()
+{
+    dbcData = createDbcData(0, MessageCount);
+    QVERIFY(dbcFile.open());
+    dbcFile.write(dbcData.toUtf8());
+    dbcFile.close();
+
+    QVERIFY(dbcDir.isValid());
+    constexpr int messagesPerFile = MessageCount / FileCount;
+    for (int i = 0; i < FileCount; ++i) {
+        QFile file(dbcDir.filePath(u"bus_%1.dbc"_s.arg(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(createDbcData(i * messagesPerFile, messagesPerFile).toUtf8());
+        dbcFileNames.push_back(file.fileName());
+    }
+}
+
+void tst_Bench_QCanDbcFileParser::peakMemory()
+{
+#ifdef Q_OS_LINUX
+    // Run first, so that the peak memory of the benchmark data generation is
+    // the baseline.
+    auto maxResidentKiB = [] {
+        struct rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+        return qint64(usage.ru_maxrss);
+    };
+
+    const qint64 before = maxResidentKiB();
+    {
+        QCanDbcFileParser parser;
+        QVERIFY(parser.parse(dbcFile.fileName()));
+        QCOMPARE(parser.messageDescriptions().size(), MessageCount);
+    }
+    QTest::setBenchmarkResult(qreal(maxResidentKiB() - before) * 1024, QTest::BytesAllocated);
+#else
+    QSKIP("Peak memory is only measured on Linux.");
+#endif
+}
+
+void tst_Bench_QCanDbcFileParser::stringStorage_data()
+{
+    QTest::addColumn<bool>("shared");
+    QTest::addColumn<bool>("fromCache");
+
+    QTest::newRow("parsed, shared") << true << false;
+    QTest::newRow("parsed, one copy per occurrence") << false << false;
+    QTest::newRow("cached, shared") << true << true;
+}
+
+// Reports the memory used by the data of the strings in the parsed descriptions,
+// compared to what the same strings would use without sharing equal ones.
+void tst_Bench_QCanDbcFileParser::stringStorage()
+{
+    QFETCH(bool, shared);
+    QFETCH(bool, fromCache);
+
+    QCanDbcFileParser parsed;
+    QVERIFY(parsed.parse(dbcFile.fileName()));
+    QCanDbcFileParser cached;
+    if (fromCache) {
+        const QString cacheFileName = dbcDir.filePath(u"strings_cache.bin"_s);
+        QVERIFY(parsed.saveCache(cacheFileName));
+        QVERIFY(cached.loadCache(cacheFileName, { dbcFile.fileName() }));
+    }
+    const QCanDbcFileParser &parser = fromCache ? cached : parsed;
+
+    qsizetype bytes = 0;
+    qsizetype occurrences = 0;
+    QSet<const QChar *> blocks;
+    auto account = [&](const QString &str) {
+        if (str.isEmpty())
+            return;
+        ++occurrences;
+        if (shared) {
+            if (blocks.contains(str.constData()))
+                return;
+            blocks.insert(str.constData());
+        }
+        bytes += sizeof(QArrayData) + str.capacity() * sizeof(QChar);
+    };
+
+    const auto messages = parser.messageDescriptions();
+    for (const QCanMessageDescription &message : messages) {
+        account(message.transmitter());
+        const auto signalDescriptions = message.signalDescriptions();
+        for (const QCanSignalDescription &signalDesc : signalDescriptions) {
+            account(signalDesc.name());
+            account(signalDesc.physicalUnit());
+            account(signalDesc.receiver());
+        }
+    }
+    const auto messageValues = parser.messageValueDescriptions();
+    for (const auto &signalValues : messageValues) {
+        for (const auto &[name, values] : signalValues.asKeyValueRange()) {
+            account(name);
+            for (const QString &description : values)
+                account(description);
+        }
+    }
+
+    QVERIFY(occurrences > 0);
+    if (shared)
+        QVERIFY(blocks.size() < occurrences / 2);
+    QTest::setBenchmarkResult(qreal(bytes), QTest::BytesAllocated);
+}
+
+void tst_Bench_QCanDbcFileParser::parseData()
+{
+    QCanDbcFileParser parser;
+    QBENCHMARK {
+        parser.parseData(dbcData);
+    }
+    QCOMPARE(parser.error(), QCanDbcFileParser::Error::None);
+    QVERIFY(parser.warnings().isEmpty());
+    QCOMPARE(parser.messageDescriptions().size(), MessageCount);
+}
+
+void tst_Bench_QCanDbcFileParser::parseFile()
+{
+    QCanDbcFileParser parser;
+    QBENCHMARK {
+        parser.parse(dbcFile.fileName());
+    }
+    QCOMPARE(parser.error(), QCanDbcFileParser::Error::None);
+    QVERIFY(parser.warnings().isEmpty());
+    QCOMPARE(parser.messageDescriptions().size(), MessageCount);
+}
+
+void tst_Bench_QCanDbcFileParser::parseMultipleFiles()
+{
+    QCanDbcFileParser parser;
+    QBENCHMARK {
+        parser.parse(dbcFileNames);
+    }
+    QCOMPARE(parser.error(), QCanDbcFileParser::Error::None);
+    QVERIFY(parser.warnings().isEmpty());
+    QCOMPARE(parser.messageDescriptions().size(), (MessageCount / FileCount) * FileCount);
+    QCOMPARE(parser.fileStatistics().size(), FileCount);
+}
+
+void tst_Bench_QCanDbcFileParser::loadCache()
+{
+    const QString cacheFileName = dbcDir.filePath(u"cache.bin"_s);
+    {
+        QCanDbcFileParser parser;
+        QVERIFY(parser.parse(dbcFile.fileName()));
+        QVERIFY(parser.saveCache(cacheFileName));
+    }
+
+    QCanDbcFileParser parser;
+    QBENCHMARK {
+        parser.loadCache(cacheFileName, { dbcFile.fileName() });
+    }
+    QCOMPARE(parser.error(), QCanDbcFileParser::Error::None);
+    QCOMPARE(parser.messageDescriptions().size(), MessageCount);
+}
+
+QTEST_MAIN(tst_Bench_QCanDbcFileParser)
+
+#include "tst_bench_qcandbcfileparser.moc"
@@ -0,0 +1,272 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qcanbusframe.h>
+#include <QtSerialBus/qcanframeprocessor.h>
+#include <QtSerialBus/qcanmessagedescription.h>
+#include <QtSerialBus/qcansignaldescription.h>
+#include <QtSerialBus/qcanuniqueiddescription.h>
+
+#include <QtCore/qrandom.h>
+#include <QtTest/qtest.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_Bench_QCanFrameProcessor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void setMessageDescriptions();
+    void parseFrame();
+    void parseFrameIntoValues();
+    void decodeFrames();
+    void prepareFrame();
+    void prepareFrameFromValues();
+    void parseColumnWithParseFrame();
+    void parseColumn();
+
+private:
+    // the number of frames per second on a fully loaded 1 Mbit/s bus is about 8000
+    static constexpr qsizetype FrameCount = 10000;
+    static constexpr quint32 MessageCount = 500;
+
+    static QCanSignalDescription makeSignal(const QString &name, QtCanBus::DataFormat format,
+                                            QSysInfo::Endian endian, quint16 startBit,
+                                            quint16 bitLength);
+
+    // frames of the first message, for the columnar decoding
+    static constexpr qsizetype ColumnFrameCount = 100000;
+
+    QCanUniqueIdDescription uniqueIdDescription;
+    QList<QCanMessageDescription> messages;
+    QList<QCanBusFrame> frames;
+    QByteArray columnPayloads;
+};
+
+QCanSignalDescription tst_Bench_QCanFrameProcessor::makeSignal(const QString &name,
+                                                               QtCanBus::DataFormat format,
+                                                               QSysInfo::Endian endian,
+                                                               quint16 startBit,
+                                                               quint16 bitLength)
+{
+    QCanSignalDescription result;
+    result.setName(name);
+    result.setDataFormat(format);
+    result.setDataEndian(endian);
+    result.setStartBit(startBit);
+    result.setBitLength(bitLength);
+    return result;
+}
+
+// Creates descriptions similar to a vehicle DBC file: hundreds of 8 byte messages
+// with a mix of little and big endian signals, scaled values, single bit flags,
+// and some multiplexed messages.
+void tst_Bench_QCanFrameProcessor::initTestCase()
+{
+    using Format = QtCanBus::DataFormat;
+    constexpr auto LE = QSysInfo::Endian::LittleEndian;
+    constexpr auto BE = QSysInfo::Endian::BigEndian;
+
+    uniqueIdDescription.setSource(QtCanBus::DataSource::FrameId);
+    uniqueIdDescription.setEndian(LE);
+    uniqueIdDescription.setStartBit(0);
+    uniqueIdDescription.setBitLength(11);
+
+    for (quint32 i = 0; i < MessageCount; ++i) {
+        QCanMessageDescription message;
+        message.setName(u"Message%1"_s.arg(i));
+        message.setUniqueId(QtCanBus::UniqueId{0x100 + i});
+        message.setSize(8);
+
+        QCanSignalDescription counter = makeSignal(u"Counter"_s, Format::UnsignedInteger, LE, 0, 8);
+        if (i % 4 == 0)
+            counter.setMultiplexState(QtCanBus::MultiplexState::MultiplexorSwitch);
+        message.addSignalDescription(counter);
+
+        QCanSignalDescription speed = makeSignal(u"Speed"_s, Format::SignedInteger, LE, 8, 12);
+        speed.setFactor(0.1);
+        message.addSignalDescription(speed);
+        message.addSignalDescription(makeSignal(u"Gear"_s, Format::UnsignedInteger, LE, 20, 4));
+        QCanSignalDescription temperature =
+                makeSignal(u"Temperature"_s, Format::SignedInteger, BE, 39, 16);
+        temperature.setFactor(0.01);
+        temperature.setOffset(-40);
+        message.addSignalDescription(temperature);
+        message.addSignalDescription(
+                makeSignal(u"Pressure"_s, Format::UnsignedInteger, BE, 53, 10));
+        for (quint16 bit = 0; bit < 3; ++bit) {
+            message.addSignalDescription(makeSignal(u"Flag%1"_s.arg(bit),
+                                                    Format::UnsignedInteger, LE, 56 + bit, 1));
+        }
+
+        if (i % 4 == 0) {
+            QCanSignalDescription low = makeSignal(u"Low"_s, Format::UnsignedInteger, LE, 24, 8);
+            low.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+            low.addMultiplexSignal(counter.name(), {{0u, 127u}});
+            message.addSignalDescription(low);
+            QCanSignalDescription high = makeSignal(u"High"_s, Format::SignedInteger, LE, 24, 8);
+            high.setMultiplexState(QtCanBus::MultiplexState::MultiplexedSignal);
+            high.addMultiplexSignal(counter.name(), {{128u, 255u}});
+            message.addSignalDescription(high);
+        }
+
+        messages.append(message);
+    }
+
+    QRandomGenerator random(42);
+    frames.reserve(FrameCount);
+    for (qsizetype i = 0; i < FrameCount; ++i) {
+        QByteArray payload(8, Qt::Uninitialized);
+        random.fillRange(reinterpret_cast<quint32 *>(payload.data()), 2);
+        frames.append(QCanBusFrame(0x100 + random.bounded(MessageCount), payload));
+    }
+
+    columnPayloads.resize(ColumnFrameCount * 8);
+    random.fillRange(reinterpret_cast<quint32 *>(columnPayloads.data()), ColumnFrameCount * 2);
+}
+
+void tst_Bench_QCanFrameProcessor::setMessageDescriptions()
+{
+    QCanFrameProcessor processor;
+    QBENCHMARK {
+        processor.setMessageDescriptions(messages);
+    }
+}
+
+void tst_Bench_QCanFrameProcessor::parseFrame()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    qsizetype decodedSignals = 0;
+    QBENCHMARK {
+        decodedSignals = 0;
+        for (const QCanBusFrame &frame : std::as_const(frames))
+            decodedSignals += processor.parseFrame(frame).signalValues.size();
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+    QVERIFY(decodedSignals > FrameCount * 8);
+}
+
+void tst_Bench_QCanFrameProcessor::parseFrameIntoValues()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    QList<double> values(processor.signalIndexCount());
+    qsizetype decodedSignals = 0;
+    QBENCHMARK {
+        decodedSignals = 0;
+        for (const QCanBusFrame &frame : std::as_const(frames))
+            decodedSignals += processor.parseFrame(frame, values);
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+    QVERIFY(decodedSignals > FrameCount * 8);
+}
+
+void tst_Bench_QCanFrameProcessor::decodeFrames()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    qsizetype decodedSignals = 0;
+    QBENCHMARK {
+        decodedSignals = 0;
+        const auto results = processor.decodeFrames(frames);
+        for (const auto &result : results)
+            decodedSignals += result.signalValues.size();
+    }
+    QVERIFY(decodedSignals > FrameCount * 8);
+}
+
+void tst_Bench_QCanFrameProcessor::prepareFrame()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    QList<std::pair<QtCanBus::UniqueId, QVariantMap>> messageValues;
+    for (const QCanBusFrame &frame : std::as_const(frames)) {
+        const auto result = processor.parseFrame(frame);
+        messageValues.append({ result.uniqueId, result.signalValues });
+    }
+
+    QBENCHMARK {
+        for (const auto &[uniqueId, signalValues] : std::as_const(messageValues))
+            processor.prepareFrame(uniqueId, signalValues);
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+}
+
+void tst_Bench_QCanFrameProcessor::prepareFrameFromValues()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    // one set of values per frame, as a simulator would hold them
+    QList<std::pair<QtCanBus::UniqueId, QList<double>>> messageValues;
+    for (const QCanBusFrame &frame : std::as_const(frames)) {
+        QList<double> values(processor.signalIndexCount());
+        processor.parseFrame(frame, values);
+        messageValues.append({ QtCanBus::UniqueId{frame.frameId()}, values });
+    }
+
+    QCanBusFrame frame;
+    qsizetype encodedSignals = 0;
+    QBENCHMARK {
+        encodedSignals = 0;
+        for (const auto &[uniqueId, values] : std::as_const(messageValues))
+            encodedSignals += processor.prepareFrame(uniqueId, values, &frame);
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+    QVERIFY(encodedSignals > FrameCount * 8);
+}
+
+void tst_Bench_QCanFrameProcessor::parseColumnWithParseFrame()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    const QtCanBus::UniqueId uniqueId{0x101};
+    const qsizetype speedIndex = processor.signalIndex(uniqueId, u"Speed"_s);
+    QList<QCanBusFrame> columnFrames;
+    columnFrames.reserve(ColumnFrameCount);
+    for (qsizetype i = 0; i < ColumnFrameCount; ++i)
+        columnFrames.append(QCanBusFrame(0x101, columnPayloads.sliced(i * 8, 8)));
+
+    QList<double> values(processor.signalIndexCount());
+    QList<double> column(ColumnFrameCount);
+    QBENCHMARK {
+        for (qsizetype i = 0; i < ColumnFrameCount; ++i) {
+            processor.parseFrame(columnFrames.at(i), values);
+            column[i] = values.at(speedIndex);
+        }
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+}
+
+void tst_Bench_QCanFrameProcessor::parseColumn()
+{
+    QCanFrameProcessor processor;
+    processor.setUniqueIdDescription(uniqueIdDescription);
+    processor.setMessageDescriptions(messages);
+
+    const QtCanBus::UniqueId uniqueId{0x101};
+    const qsizetype speedIndex = processor.signalIndex(uniqueId, u"Speed"_s);
+    QList<double> column(ColumnFrameCount);
+    QBENCHMARK {
+        processor.parseColumn(uniqueId, speedIndex, columnPayloads, column);
+    }
+    QCOMPARE(processor.error(), QCanFrameProcessor::Error::None);
+}
+
+QTEST_MAIN(tst_Bench_QCanFrameProcessor)
+
+#include "tst_bench_qcanframeprocessor.moc"
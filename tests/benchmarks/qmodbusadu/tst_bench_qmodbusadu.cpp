@@ -0,0 +1,133 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/private/qmodbusadu_p.h>
+
+#include <QtCore/qrandom.h>
+#include <QtTest/qtest.h>
+
+// The bit-by-bit implementation previously used by QModbusSerialAdu, for comparison
+static quint16 bitwiseCRC(const char *data, qint32 len)
+{
+    quint16 crc = 0xFFFF;
+    while (len--) {
+        const quint8 c = *data++;
+        for (qint32 i = 0x01; i & 0xFF; i <<= 1) {
+            bool bit = crc & 0x8000;
+            if (c & i)
+                bit = !bit;
+            crc <<= 1;
+            if (bit)
+                crc ^= 0x8005;
+        }
+    }
+    quint16 reflected = crc & 0x01;
+    for (qint32 i = 1; i < 16; i++) {
+        crc >>= 1;
+        reflected = (reflected << 1) | (crc & 0x01);
+    }
+    return (reflected >> 8) | (reflected << 8); // swap bytes
+}
+
+class tst_Bench_QModbusAdu : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void calculateCRC_data();
+    void calculateCRC();
+    void consumeBurst_data();
+    void consumeBurst();
+
+private:
+    static constexpr qsizetype AduCount = 1000;
+};
+
+void tst_Bench_QModbusAdu::calculateCRC_data()
+{
+    QTest::addColumn<bool>("bitwise");
+    QTest::addColumn<qint32>("length");
+
+    // a write single register request, a typical read response and the largest RTU ADU
+    for (qint32 length : { 6, 32, 254 }) {
+        QTest::addRow("bitwise-%d", length) << true << length;
+        QTest::addRow("table-%d", length) << false << length;
+    }
+}
+
+void tst_Bench_QModbusAdu::calculateCRC()
+{
+    QFETCH(bool, bitwise);
+    QFETCH(qint32, length);
+
+    // a few spare bytes, so every call below sees a different (and unaligned) ADU
+    QByteArray data(length + 3, Qt::Uninitialized);
+    QRandomGenerator generator(0x8005);
+    for (char &c : data)
+        c = char(generator.bounded(256));
+
+    quint32 sum = 0;
+    QBENCHMARK {
+        for (qsizetype i = 0; i < AduCount; ++i) {
+            const char *adu = data.constData() + (i & 3);
+            sum += bitwise ? bitwiseCRC(adu, length) : QModbusSerialAdu::calculateCRC(adu, length);
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_Bench_QModbusAdu::consumeBurst_data()
+{
+    QTest::addColumn<bool>("readCursor");
+    QTest::addColumn<int>("aduCount");
+
+    for (int aduCount : { 100, 1000, 10000 }) {
+        QTest::addRow("remove-%d", aduCount) << false << aduCount;
+        QTest::addRow("cursor-%d", aduCount) << true << aduCount;
+    }
+}
+
+// Takes the TCP ADUs of a pipelined burst from the front of the receive buffer one by one,
+// either removing the consumed bytes every time or advancing a read cursor
+void tst_Bench_QModbusAdu::consumeBurst()
+{
+    QFETCH(bool, readCursor);
+    QFETCH(int, aduCount);
+
+    QModbusTcpAdu::Header header;
+    header.unitId = 1;
+    const QModbusRequest request(QModbusRequest::ReadHoldingRegisters, quint16(0), quint16(2));
+    QByteArray burst;
+    for (int i = 0; i < aduCount; ++i) {
+        header.transactionId = quint16(i);
+        burst += QModbusTcpAdu::create(header, request);
+    }
+
+    quint32 sum = 0;
+    QBENCHMARK {
+        if (readCursor) {
+            QModbusReceiveBuffer buffer;
+            buffer.append(burst);
+            while (!buffer.isEmpty()) {
+                header = QModbusTcpAdu::readHeader(buffer.constData());
+                const qsizetype pduSize = header.length - 1;
+                sum += buffer.pdu<QModbusRequest>(QModbusTcpAdu::HeaderSize, pduSize).size();
+                buffer.consume(QModbusTcpAdu::HeaderSize + pduSize);
+            }
+        } else {
+            QByteArray buffer = burst;
+            while (!buffer.isEmpty()) {
+                header = QModbusTcpAdu::readHeader(buffer.constData());
+                const qsizetype pduSize = header.length - 1;
+                sum += QModbusTcpAdu::pduFromBuffer<QModbusRequest>(buffer,
+                    QModbusTcpAdu::HeaderSize, pduSize).size();
+                buffer.remove(0, QModbusTcpAdu::HeaderSize + pduSize);
+            }
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+QTEST_MAIN(tst_Bench_QModbusAdu)
+
+#include "tst_bench_qmodbusadu.moc"
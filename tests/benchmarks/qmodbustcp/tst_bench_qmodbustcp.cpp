@@ -0,0 +1,161 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qmodbustcpclient.h>
+#include <QtSerialBus/qmodbustcpserver.h>
+#include <QtSerialBus/private/qmodbusadu_p.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/qtest.h>
+
+using namespace Qt::StringLiterals;
+
+// The benchmark runs a Modbus TCP server and client on localhost. The port can be changed
+// with the environment variable QT_BENCH_MODBUS_PORT.
+
+class tst_Bench_QModbusTcp : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void requests_data();
+    void requests();
+    void burst_data();
+    void burst();
+
+private:
+    void sendRequest();
+
+    QModbusTcpServer server;
+    QModbusTcpClient client;
+
+    static constexpr int ServerAddress = 1;
+    static constexpr int RequestCount = 10000;
+    const QModbusDataUnit unit { QModbusDataUnit::HoldingRegisters, 0, 10 };
+    int sent = 0;
+    int finished = 0;
+    int failed = 0;
+};
+
+void tst_Bench_QModbusTcp::initTestCase()
+{
+    const int port = qEnvironmentVariableIntValue("QT_BENCH_MODBUS_PORT");
+
+    QModbusDataUnitMap map;
+    map.insert(QModbusDataUnit::HoldingRegisters, { QModbusDataUnit::HoldingRegisters, 0, 100 });
+    server.setMap(map);
+    server.setServerAddress(ServerAddress);
+    server.setConnectionParameter(QModbusDevice::NetworkAddressParameter, u"127.0.0.1"_s);
+    server.setConnectionParameter(QModbusDevice::NetworkPortParameter, port ? port : 50200);
+    if (!server.connectDevice())
+        QSKIP(qPrintable(u"Cannot listen on localhost: %1"_s.arg(server.errorString())));
+
+    client.setConnectionParameter(QModbusDevice::NetworkAddressParameter, u"127.0.0.1"_s);
+    client.setConnectionParameter(QModbusDevice::NetworkPortParameter,
+                                  server.connectionParameter(QModbusDevice::NetworkPortParameter));
+    QVERIFY(client.connectDevice());
+    QTRY_COMPARE(client.state(), QModbusDevice::ConnectedState);
+}
+
+void tst_Bench_QModbusTcp::cleanupTestCase()
+{
+    client.disconnectDevice();
+    server.disconnectDevice();
+}
+
+void tst_Bench_QModbusTcp::sendRequest()
+{
+    ++sent;
+    QModbusReply *reply = client.sendReadRequest(unit, ServerAddress);
+    if (!reply) {
+        ++failed;
+        ++finished;
+        return;
+    }
+
+    connect(reply, &QModbusReply::finished, this, [this, reply]() {
+        if (reply->error() != QModbusDevice::NoError)
+            ++failed;
+        ++finished;
+        reply->deleteLater();
+        if (sent < RequestCount)
+            sendRequest();
+    });
+}
+
+void tst_Bench_QModbusTcp::requests_data()
+{
+    QTest::addColumn<int>("inFlight");
+
+    QTest::newRow("sequential") << 1;
+    QTest::newRow("pipelined-8") << 8;
+    QTest::newRow("pipelined-32") << 32;
+    QTest::newRow("pipelined-1000") << 1000;
+}
+
+// Read requests answered by the server, with a number of requests in flight at any time
+void tst_Bench_QModbusTcp::requests()
+{
+    QFETCH(int, inFlight);
+
+    qint64 total = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        sent = finished = failed = 0;
+        for (int i = 0; i < inFlight; ++i)
+            sendRequest();
+        QTRY_COMPARE_WITH_TIMEOUT(finished, RequestCount, 30000);
+        QCOMPARE(failed, 0);
+        total += RequestCount;
+    }
+    const qint64 elapsed = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    qDebug("%lld requests, %.0f requests/s", total, double(total) * 1e9 / double(elapsed));
+}
+
+void tst_Bench_QModbusTcp::burst_data()
+{
+    QTest::addColumn<int>("requestCount");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+// Read requests written to the server in a single TCP write, bypassing the client
+void tst_Bench_QModbusTcp::burst()
+{
+    QFETCH(int, requestCount);
+
+    QModbusTcpAdu::Header header;
+    header.unitId = ServerAddress;
+    const QModbusRequest request(QModbusRequest::ReadHoldingRegisters, quint16(0), quint16(10));
+    QByteArray requests;
+    for (int i = 0; i < requestCount; ++i) {
+        header.transactionId = quint16(i);
+        requests += QModbusTcpAdu::create(header, request);
+    }
+    // MBAP header, function code, byte count and ten registers
+    const qsizetype responsesSize = qsizetype(requestCount) * (QModbusTcpAdu::HeaderSize + 22);
+
+    QTcpSocket socket;
+    qsizetype received = 0;
+    connect(&socket, &QTcpSocket::readyRead, this, [&]() { received += socket.readAll().size(); });
+    socket.connectToHost(QHostAddress::LocalHost,
+        quint16(server.connectionParameter(QModbusDevice::NetworkPortParameter).toInt()));
+    QTRY_COMPARE(socket.state(), QAbstractSocket::ConnectedState);
+
+    QBENCHMARK {
+        received = 0;
+        socket.write(requests);
+        QTRY_COMPARE_WITH_TIMEOUT(received, responsesSize, 30000);
+    }
+}
+
+QTEST_MAIN(tst_Bench_QModbusTcp)
+
+#include "tst_bench_qmodbustcp.moc"
@@ -0,0 +1,197 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtSerialBus/qcanbus.h>
+#include <QtSerialBus/qcanbusdevice.h>
+#include <QtSerialBus/qcanbusframe.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qthread.h>
+#include <QtTest/qtest.h>
+
+#include <linux/can.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+using namespace Qt::StringLiterals;
+
+// The benchmarks need a virtual CAN interface, which can be set up with:
+//     sudo modprobe vcan
+//     sudo ip link add dev vcan0 type vcan
+//     sudo ip link set up vcan0
+// The interface name can be changed with the environment variable QT_BENCH_SOCKETCAN_DEVICE.
+// Use "strace -c -e trace=recvmsg,recvmmsg,ioctl" to compare the number of system calls.
+
+class tst_Bench_SocketCan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void receive_data();
+    void receive();
+    void blockedMainThread_data();
+    void blockedMainThread();
+
+private:
+    std::unique_ptr<QCanBusDevice> createDevice() const;
+
+    QString interfaceName;
+};
+
+std::unique_ptr<QCanBusDevice> tst_Bench_SocketCan::createDevice() const
+{
+    std::unique_ptr<QCanBusDevice> device(
+                QCanBus::instance()->createDevice(u"socketcan"_s, interfaceName));
+    return device;
+}
+
+void tst_Bench_SocketCan::initTestCase()
+{
+    interfaceName = qEnvironmentVariable("QT_BENCH_SOCKETCAN_DEVICE", u"vcan0"_s);
+
+    if (!QCanBus::instance()->plugins().contains(u"socketcan"_s))
+        QSKIP("The SocketCAN plugin is not available.");
+
+    std::unique_ptr<QCanBusDevice> device = createDevice();
+    if (!device || !device->connectDevice())
+        QSKIP(qPrintable(u"The CAN interface %1 is not available."_s.arg(interfaceName)));
+}
+
+void tst_Bench_SocketCan::receive_data()
+{
+    QTest::addColumn<int>("batchSize");
+
+    QTest::newRow("unbatched") << 1;
+    QTest::newRow("batch-8") << 8;
+    QTest::newRow("batch-32") << 32;
+    QTest::newRow("batch-128") << 128;
+}
+
+void tst_Bench_SocketCan::receive()
+{
+    QFETCH(int, batchSize);
+
+    // frames sent in one go, must fit into the default socket receive buffer
+    constexpr int burstSize = 100;
+    constexpr int burstCount = 100;
+
+    std::unique_ptr<QCanBusDevice> sender = createDevice();
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(sender && receiver);
+    receiver->setConfigurationParameter(QCanBusDevice::ReceiveBatchSizeKey, batchSize);
+    QVERIFY(sender->connectDevice());
+    QVERIFY(receiver->connectDevice());
+
+    const QCanBusFrame frame(0x123, QByteArray::fromHex("0102030405060708"));
+
+    qint64 received = 0;
+    qint64 totalReceived = 0;
+    qint64 notifications = 0;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this, [&]() {
+        ++notifications;
+        const qint64 count = receiver->readAllFrames().size();
+        received += count;
+        totalReceived += count;
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        received = 0;
+        for (int burst = 0; burst < burstCount; ++burst) {
+            for (int i = 0; i < burstSize; ++i)
+                sender->writeFrame(frame);
+            const qint64 expected = qint64(burst + 1) * burstSize;
+            QTRY_COMPARE_WITH_TIMEOUT(received, expected, 1000);
+        }
+    }
+    const qint64 elapsed = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    qDebug("%lld frames in %lld notifications, %.0f frames/s", totalReceived, notifications,
+           double(totalReceived) * 1e9 / double(elapsed));
+}
+
+void tst_Bench_SocketCan::blockedMainThread_data()
+{
+    QTest::addColumn<bool>("receiveThread");
+
+    QTest::newRow("event-loop") << false;
+    QTest::newRow("receive-thread") << true;
+}
+
+void tst_Bench_SocketCan::blockedMainThread()
+{
+    QFETCH(bool, receiveThread);
+
+    // roughly the frame rate of a fully loaded 1 Mbit/s bus
+    constexpr int framesPerMillisecond = 8;
+    constexpr int frameCount = 4000;
+    constexpr int blockTime = 200;
+
+    std::unique_ptr<QCanBusDevice> receiver = createDevice();
+    QVERIFY(receiver);
+    receiver->setConfigurationParameter(QCanBusDevice::ReceiveThreadKey, receiveThread);
+    QVERIFY(receiver->connectDevice());
+
+    qint64 received = 0;
+    connect(receiver.get(), &QCanBusDevice::framesReceived, this, [&]() {
+        received += receiver->readAllFrames().size();
+    });
+
+    // the sender must not depend on the blocked event loop, so it uses a raw socket
+    const int senderSocket = ::socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    QVERIFY(senderSocket >= 0);
+    sockaddr_can address = {};
+    address.can_family = AF_CAN;
+    address.can_ifindex = int(::if_nametoindex(interfaceName.toLatin1().constData()));
+    QVERIFY(::bind(senderSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+
+    std::atomic<int> sent = 0;
+    std::thread sender([&]() {
+        can_frame frame = {};
+        frame.can_id = 0x123;
+        frame.len = 8;
+        std::memcpy(frame.data, "\x01\x02\x03\x04\x05\x06\x07\x08", 8);
+
+        while (sent.load() < frameCount) {
+            for (int i = 0; i < framesPerMillisecond && sent.load() < frameCount; ++i) {
+                if (::write(senderSocket, &frame, sizeof(frame)) == sizeof(frame))
+                    ++sent;
+                else if (errno != ENOBUFS && errno != EAGAIN)
+                    return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // keep the event loop of the device's thread busy while the frames arrive
+    QThread::msleep(blockTime);
+
+    sender.join();
+    ::close(senderSocket);
+    QCOMPARE(sent.load(), frameCount);
+
+    if (receiveThread) {
+        QTRY_COMPARE_WITH_TIMEOUT(received, qint64(frameCount), 5000);
+        QCOMPARE(receiver->framesDropped(), 0);
+    } else {
+        // frames lost in the kernel socket buffer never show up, so just wait a bit
+        QTest::qWait(500);
+    }
+
+    qDebug("%lld of %d frames received, %lld dropped from the receive queue", received,
+           frameCount, receiver->framesDropped());
+}
+
+QTEST_MAIN(tst_Bench_SocketCan)
+
+#include "tst_bench_socketcan.moc"